@@ -0,0 +1,634 @@
+// bcenc.c — BC1 / BC3 / BC7 (mode 6) block compression
+//   - BC1/BC3 : axe principal + moindres carrés (à la stb_dxt), alpha BC3 en 8 ou 6 valeurs
+//   - BC7     : mode 6 seul (RGBA 7.7.7.7 + p-bit, index 4 bits), rapide et sans partitions
+//   - recherche d'index en SSE2 (4 pixels à la fois), lignes de blocs réparties sur N threads
+#include "bcenc.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <float.h>
+#include <math.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define BCENC_SSE2 1
+#else
+    #define BCENC_SSE2 0
+#endif
+
+// ---------------- errors / small utils ----------------
+static char gError[256];
+
+void bcenc_set_error(const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(gError, sizeof(gError), fmt, ap);
+    va_end(ap);
+}
+const char *bcenc_last_error(void) { return gError; }
+void bcenc_free(void *p) { free(p); }
+
+static int ClampInt(int v, int lo, int hi) { return v < lo ? lo : (v > hi ? hi : v); }
+static float ClampF(float v, float lo, float hi) { return v < lo ? lo : (v > hi ? hi : v); }
+
+static int CpuCount(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return (int)si.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+int bcenc_parse_format(const char *name) {
+    if (!name) return BCENC_FORMAT_NONE;
+    char up[32];
+    size_t n = 0;
+    for (; name[n] && n < sizeof(up) - 1; ++n) up[n] = (char)toupper((unsigned char)name[n]);
+    up[n] = 0;
+    if (!strcmp(up, "BC1") || !strcmp(up, "DXT1") || !strncmp(up, "BC1_UNORM", 9)) return BCENC_FORMAT_BC1;
+    if (!strcmp(up, "BC3") || !strcmp(up, "DXT5") || !strncmp(up, "BC3_UNORM", 9)) return BCENC_FORMAT_BC3;
+    if (!strcmp(up, "BC7") || !strncmp(up, "BC7_UNORM", 9)) return BCENC_FORMAT_BC7;
+    return BCENC_FORMAT_NONE;
+}
+
+static int BlockBytes(int format) { return format == BCENC_FORMAT_BC1 ? 8 : 16; }
+
+size_t bcenc_surface_size(int format, int width, int height) {
+    size_t bx = (size_t)((width + 3) / 4), by = (size_t)((height + 3) / 4);
+    if (bx < 1) bx = 1;
+    if (by < 1) by = 1;
+    return bx * by * (size_t)BlockBytes(format);
+}
+
+// Bloc 4x4 RGBA, bords répliqués si l'image n'est pas multiple de 4
+static void LoadBlock(const uint8_t *rgba, int w, int h, int bx, int by, uint8_t blk[16][4]) {
+    for (int y = 0; y < 4; ++y) {
+        int sy = by * 4 + y; if (sy >= h) sy = h - 1;
+        for (int x = 0; x < 4; ++x) {
+            int sx = bx * 4 + x; if (sx >= w) sx = w - 1;
+            memcpy(blk[y * 4 + x], rgba + ((size_t)sy * w + sx) * 4, 4);
+        }
+    }
+}
+
+// ---------------- index search (hot loop) ----------------
+// Pour chaque pixel, index de l'entrée de palette la plus proche (distance RGBA pondérée par
+// canal `cw` et par pixel `pw`). px est en SoA: px[canal][pixel]. Retourne l'erreur totale.
+static float FitIndices(const float px[4][16], const float pw[16], const float pal[16][4], int n,
+                        const float cw[4], uint8_t idx[16]) {
+#if BCENC_SSE2
+    __m128 total = _mm_setzero_ps();
+    const __m128 w0 = _mm_set1_ps(cw[0]), w1 = _mm_set1_ps(cw[1]), w2 = _mm_set1_ps(cw[2]), w3 = _mm_set1_ps(cw[3]);
+    for (int i = 0; i < 16; i += 4) {
+        const __m128 r = _mm_loadu_ps(&px[0][i]), g = _mm_loadu_ps(&px[1][i]);
+        const __m128 b = _mm_loadu_ps(&px[2][i]), a = _mm_loadu_ps(&px[3][i]);
+        __m128 best = _mm_set1_ps(FLT_MAX), bi = _mm_setzero_ps();
+        for (int k = 0; k < n; ++k) {
+            __m128 dr = _mm_sub_ps(r, _mm_set1_ps(pal[k][0]));
+            __m128 dg = _mm_sub_ps(g, _mm_set1_ps(pal[k][1]));
+            __m128 db = _mm_sub_ps(b, _mm_set1_ps(pal[k][2]));
+            __m128 da = _mm_sub_ps(a, _mm_set1_ps(pal[k][3]));
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, _mm_mul_ps(dr, dr)), _mm_mul_ps(w1, _mm_mul_ps(dg, dg))),
+                                  _mm_add_ps(_mm_mul_ps(w2, _mm_mul_ps(db, db)), _mm_mul_ps(w3, _mm_mul_ps(da, da))));
+            __m128 lt = _mm_cmplt_ps(d, best);
+            best = _mm_min_ps(d, best);
+            bi = _mm_or_ps(_mm_and_ps(lt, _mm_set1_ps((float)k)), _mm_andnot_ps(lt, bi));
+        }
+        total = _mm_add_ps(total, _mm_mul_ps(best, _mm_loadu_ps(&pw[i])));
+        float t[4];
+        _mm_storeu_ps(t, bi);
+        for (int j = 0; j < 4; ++j) idx[i + j] = (uint8_t)t[j];
+    }
+    float t[4];
+    _mm_storeu_ps(t, total);
+    return t[0] + t[1] + t[2] + t[3];
+#else
+    float total = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float best = FLT_MAX;
+        int bi = 0;
+        for (int k = 0; k < n; ++k) {
+            float d = 0.0f;
+            for (int c = 0; c < 4; ++c) { float e = px[c][i] - pal[k][c]; d += cw[c] * e * e; }
+            if (d < best) { best = d; bi = k; }
+        }
+        idx[i] = (uint8_t)bi;
+        total += best * pw[i];
+    }
+    return total;
+#endif
+}
+
+// Axe principal (itération de puissance) sur les pixels de poids non nul, `nc` canaux
+static void PrincipalAxis(const float px[4][16], const float pw[16], int nc, float mean[4], float axis[4]) {
+    float cov[4][4] = {{0}}, wsum = 0.0f;
+    for (int c = 0; c < 4; ++c) { mean[c] = 0.0f; axis[c] = 0.0f; }
+    for (int i = 0; i < 16; ++i) { wsum += pw[i]; for (int c = 0; c < nc; ++c) mean[c] += pw[i] * px[c][i]; }
+    if (wsum <= 0.0f) return;
+    for (int c = 0; c < nc; ++c) mean[c] /= wsum;
+    for (int i = 0; i < 16; ++i) {
+        if (pw[i] <= 0.0f) continue;
+        for (int a = 0; a < nc; ++a)
+            for (int b = a; b < nc; ++b)
+                cov[a][b] += (px[a][i] - mean[a]) * (px[b][i] - mean[b]);
+    }
+    for (int a = 0; a < nc; ++a) for (int b = 0; b < a; ++b) cov[a][b] = cov[b][a];
+    for (int c = 0; c < nc; ++c) axis[c] = 1.0f;
+    for (int it = 0; it < 8; ++it) {
+        float v[4] = {0}, len = 0.0f;
+        for (int a = 0; a < nc; ++a) for (int b = 0; b < nc; ++b) v[a] += cov[a][b] * axis[b];
+        for (int a = 0; a < nc; ++a) len = fmaxf(len, fabsf(v[a]));
+        if (len < 1e-8f) return;   // bloc uni (ou presque): l'axe n'a pas d'importance
+        for (int a = 0; a < nc; ++a) axis[a] = v[a] / len;
+    }
+}
+
+// Extrémités = pixels extrêmes le long de l'axe
+static void AxisExtremes(const float px[4][16], const float pw[16], int nc, const float mean[4],
+                         const float axis[4], float lo[4], float hi[4]) {
+    float mn = FLT_MAX, mx = -FLT_MAX;
+    int imn = -1, imx = -1;
+    for (int i = 0; i < 16; ++i) {
+        if (pw[i] <= 0.0f) continue;
+        float d = 0.0f;
+        for (int c = 0; c < nc; ++c) d += (px[c][i] - mean[c]) * axis[c];
+        if (d < mn) { mn = d; imn = i; }
+        if (d > mx) { mx = d; imx = i; }
+    }
+    for (int c = 0; c < 4; ++c) {
+        lo[c] = imn >= 0 ? px[c][imn] : 0.0f;
+        hi[c] = imx >= 0 ? px[c][imx] : 0.0f;
+    }
+}
+
+// Moindres carrés: e0,e1 minimisant sum |(1-t_i) e0 + t_i e1 - p_i|^2
+static int LeastSquares(const float px[4][16], const float pw[16], const float t[16], int nc, float e0[4], float e1[4]) {
+    float A = 0, B = 0, C = 0, X0[4] = {0}, X1[4] = {0};
+    for (int i = 0; i < 16; ++i) {
+        if (pw[i] <= 0.0f) continue;
+        float u = 1.0f - t[i], v = t[i];
+        A += u * u; B += u * v; C += v * v;
+        for (int c = 0; c < nc; ++c) { X0[c] += u * px[c][i]; X1[c] += v * px[c][i]; }
+    }
+    float det = A * C - B * B;
+    if (fabsf(det) < 1e-6f) return 0;
+    for (int c = 0; c < nc; ++c) {
+        e0[c] = ClampF((C * X0[c] - B * X1[c]) / det, 0.0f, 255.0f);
+        e1[c] = ClampF((A * X1[c] - B * X0[c]) / det, 0.0f, 255.0f);
+    }
+    return 1;
+}
+
+// ---------------- BC1 color block ----------------
+static uint16_t Pack565(const float c[4]) {
+    int r = ClampInt((int)(c[0] * 31.0f / 255.0f + 0.5f), 0, 31);
+    int g = ClampInt((int)(c[1] * 63.0f / 255.0f + 0.5f), 0, 63);
+    int b = ClampInt((int)(c[2] * 31.0f / 255.0f + 0.5f), 0, 31);
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+static void Unpack565(uint16_t v, int c[3]) {
+    int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+    c[0] = (r << 3) | (r >> 2);
+    c[1] = (g << 2) | (g >> 4);
+    c[2] = (b << 3) | (b >> 2);
+}
+// Palette BC1 telle que la décode le GPU (même arrondi que DecodeColorBlock)
+static int Bc1Palette(uint16_t c0, uint16_t c1, float pal[16][4]) {
+    int a[3], b[3];
+    Unpack565(c0, a);
+    Unpack565(c1, b);
+    for (int c = 0; c < 3; ++c) {
+        pal[0][c] = (float)a[c];
+        pal[1][c] = (float)b[c];
+        if (c0 > c1) {
+            pal[2][c] = (float)((2 * a[c] + b[c]) / 3);
+            pal[3][c] = (float)((a[c] + 2 * b[c]) / 3);
+        } else {
+            pal[2][c] = (float)((a[c] + b[c]) / 2);
+            pal[3][c] = 0.0f;
+        }
+    }
+    for (int k = 0; k < 4; ++k) pal[k][3] = 0.0f;
+    return c0 > c1 ? 4 : 3;
+}
+
+typedef struct { uint16_t c0, c1; uint8_t idx[16]; float err; } Bc1Try;
+
+static void Bc1TryEndpoints(const float px[4][16], const float pw[16], const float e0[4], const float e1[4],
+                            int threeColor, Bc1Try *out) {
+    static const float kColorW[4] = {1.0f, 1.0f, 1.0f, 0.0f};
+    float pal[16][4];
+    uint16_t c0 = Pack565(e0), c1 = Pack565(e1);
+    // 4 couleurs => c0 > c1 ; 3 couleurs (+ transparent) => c0 <= c1
+    if (threeColor ? (c0 > c1) : (c0 < c1)) { uint16_t t = c0; c0 = c1; c1 = t; }
+    out->c0 = c0;
+    out->c1 = c1;
+    if (c0 == c1 && !threeColor) {
+        Bc1Palette(c0, c1, pal);
+        memset(out->idx, 0, 16);
+        out->err = FitIndices(px, pw, pal, 1, kColorW, out->idx);
+        return;
+    }
+    int n = Bc1Palette(c0, c1, pal);
+    out->err = FitIndices(px, pw, pal, n > 3 ? 4 : 3, kColorW, out->idx);
+    if (threeColor) for (int i = 0; i < 16; ++i) if (pw[i] <= 0.0f) out->idx[i] = 3;
+}
+
+static void EncodeColorBlock(const uint8_t blk[16][4], int allowTransparent, uint8_t out[8]) {
+    float px[4][16], pw[16];
+    int transparent = 0, opaque = 0;
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 4; ++c) px[c][i] = (float)blk[i][c];
+        pw[i] = (allowTransparent && blk[i][3] < 128) ? 0.0f : 1.0f;
+        if (pw[i] > 0.0f) opaque++; else transparent = 1;
+    }
+    if (opaque == 0) {
+        // tout transparent: c0 = c1 = 0 (mode 3 couleurs), index 3 partout
+        memset(out, 0, 4);
+        memset(out + 4, 0xFF, 4);
+        return;
+    }
+
+    float mean[4], axis[4], lo[4], hi[4];
+    PrincipalAxis(px, pw, 3, mean, axis);
+    AxisExtremes(px, pw, 3, mean, axis, lo, hi);
+    // léger inset pour viser le centre des intervalles de quantification
+    for (int c = 0; c < 3; ++c) {
+        float inset = (hi[c] - lo[c]) / 16.0f;
+        hi[c] = ClampF(hi[c] - inset, 0.0f, 255.0f);
+        lo[c] = ClampF(lo[c] + inset, 0.0f, 255.0f);
+    }
+
+    Bc1Try best, cur;
+    Bc1TryEndpoints(px, pw, hi, lo, transparent, &best);
+    for (int iter = 0; iter < 2; ++iter) {
+        float t[16], e0[4], e1[4];
+        int four = best.c0 > best.c1;
+        for (int i = 0; i < 16; ++i) {
+            static const float k4[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+            static const float k3[4] = {0.0f, 1.0f, 0.5f, 0.0f};
+            t[i] = four ? k4[best.idx[i]] : k3[best.idx[i]];
+        }
+        if (!LeastSquares(px, pw, t, 3, e0, e1)) break;
+        Bc1TryEndpoints(px, pw, e0, e1, transparent, &cur);
+        if (cur.err < best.err) best = cur; else break;
+    }
+
+    out[0] = (uint8_t)(best.c0 & 0xFF); out[1] = (uint8_t)(best.c0 >> 8);
+    out[2] = (uint8_t)(best.c1 & 0xFF); out[3] = (uint8_t)(best.c1 >> 8);
+    uint32_t bits = 0;
+    for (int i = 0; i < 16; ++i) bits |= (uint32_t)(best.idx[i] & 3) << (2 * i);
+    out[4] = (uint8_t)bits; out[5] = (uint8_t)(bits >> 8); out[6] = (uint8_t)(bits >> 16); out[7] = (uint8_t)(bits >> 24);
+}
+
+static void DecodeColorBlock(const uint8_t in[8], int bc1Alpha, uint8_t blk[16][4]) {
+    uint16_t c0 = (uint16_t)(in[0] | (in[1] << 8)), c1 = (uint16_t)(in[2] | (in[3] << 8));
+    float pal[16][4];
+    Bc1Palette(c0, c1, pal);
+    uint32_t bits = (uint32_t)in[4] | ((uint32_t)in[5] << 8) | ((uint32_t)in[6] << 16) | ((uint32_t)in[7] << 24);
+    for (int i = 0; i < 16; ++i) {
+        int k = (bits >> (2 * i)) & 3;
+        for (int c = 0; c < 3; ++c) blk[i][c] = (uint8_t)pal[k][c];
+        blk[i][3] = (bc1Alpha && c0 <= c1 && k == 3) ? 0 : 255;
+    }
+}
+
+// ---------------- BC3 alpha block ----------------
+static void AlphaPalette(int a0, int a1, int pal[8]) {
+    pal[0] = a0; pal[1] = a1;
+    if (a0 > a1) {
+        for (int i = 1; i < 7; ++i) pal[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+    } else {
+        for (int i = 1; i < 5; ++i) pal[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+        pal[6] = 0; pal[7] = 255;
+    }
+}
+
+static int FitAlpha(const uint8_t blk[16][4], int a0, int a1, uint8_t idx[16]) {
+    int pal[8], err = 0;
+    AlphaPalette(a0, a1, pal);
+    for (int i = 0; i < 16; ++i) {
+        int best = INT32_MAX, bi = 0;
+        for (int k = 0; k < 8; ++k) {
+            int d = blk[i][3] - pal[k];
+            d *= d;
+            if (d < best) { best = d; bi = k; }
+        }
+        idx[i] = (uint8_t)bi;
+        err += best;
+    }
+    return err;
+}
+
+static void EncodeAlphaBlock(const uint8_t blk[16][4], uint8_t out[8]) {
+    int mn = 255, mx = 0, mn6 = 255, mx6 = 0;
+    for (int i = 0; i < 16; ++i) {
+        int a = blk[i][3];
+        if (a < mn) mn = a;
+        if (a > mx) mx = a;
+        if (a != 0 && a != 255) { if (a < mn6) mn6 = a; if (a > mx6) mx6 = a; }
+    }
+    uint8_t idx8[16], idx6[16];
+    int a0 = mx, a1 = mn;
+    int err8 = FitAlpha(blk, a0, a1, idx8);
+    int b0 = mn6 <= mx6 ? mn6 : 0, b1 = mn6 <= mx6 ? mx6 : 0;
+    int err6 = FitAlpha(blk, b0, b1, idx6);
+    const uint8_t *idx = idx8;
+    if (err6 < err8) { a0 = b0; a1 = b1; idx = idx6; }
+    out[0] = (uint8_t)a0;
+    out[1] = (uint8_t)a1;
+    uint64_t bits = 0;
+    for (int i = 0; i < 16; ++i) bits |= (uint64_t)(idx[i] & 7) << (3 * i);
+    for (int b = 0; b < 6; ++b) out[2 + b] = (uint8_t)(bits >> (8 * b));
+}
+
+static void DecodeAlphaBlock(const uint8_t in[8], uint8_t blk[16][4]) {
+    int pal[8];
+    AlphaPalette(in[0], in[1], pal);
+    uint64_t bits = 0;
+    for (int b = 0; b < 6; ++b) bits |= (uint64_t)in[2 + b] << (8 * b);
+    for (int i = 0; i < 16; ++i) blk[i][3] = (uint8_t)pal[(bits >> (3 * i)) & 7];
+}
+
+// ---------------- BC7 mode 6 ----------------
+static const int kBc7W4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+typedef struct { int q0[4], q1[4], p0, p1; uint8_t idx[16]; float err; } Bc7Try;
+
+static void Bc7Palette(const int q0[4], const int q1[4], int p0, int p1, float pal[16][4]) {
+    for (int c = 0; c < 4; ++c) {
+        int e0 = (q0[c] << 1) | p0, e1 = (q1[c] << 1) | p1;
+        for (int k = 0; k < 16; ++k) pal[k][c] = (float)(((64 - kBc7W4[k]) * e0 + kBc7W4[k] * e1 + 32) >> 6);
+    }
+}
+
+static void Bc7TryEndpoints(const float px[4][16], const float pw[16], const float e0[4], const float e1[4], Bc7Try *best) {
+    static const float kW[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    for (int p = 0; p < 4; ++p) {
+        Bc7Try t;
+        t.p0 = p & 1;
+        t.p1 = p >> 1;
+        for (int c = 0; c < 4; ++c) {
+            t.q0[c] = ClampInt((int)lrintf((e0[c] - t.p0) * 0.5f), 0, 127);
+            t.q1[c] = ClampInt((int)lrintf((e1[c] - t.p1) * 0.5f), 0, 127);
+        }
+        float pal[16][4];
+        Bc7Palette(t.q0, t.q1, t.p0, t.p1, pal);
+        t.err = FitIndices(px, pw, pal, 16, kW, t.idx);
+        if (t.err < best->err) *best = t;
+    }
+}
+
+typedef struct { uint8_t *p; int bit; } BitWriter;
+static void PutBits(BitWriter *w, uint32_t v, int n) {
+    for (int i = 0; i < n; ++i, ++w->bit)
+        if ((v >> i) & 1) w->p[w->bit >> 3] |= (uint8_t)(1u << (w->bit & 7));
+}
+static uint32_t GetBits(const uint8_t *p, int *bit, int n) {
+    uint32_t v = 0;
+    for (int i = 0; i < n; ++i, ++*bit) v |= (uint32_t)((p[*bit >> 3] >> (*bit & 7)) & 1) << i;
+    return v;
+}
+
+static void EncodeBc7Block(const uint8_t blk[16][4], uint8_t out[16]) {
+    float px[4][16], pw[16];
+    for (int i = 0; i < 16; ++i) { pw[i] = 1.0f; for (int c = 0; c < 4; ++c) px[c][i] = (float)blk[i][c]; }
+    float mean[4], axis[4], lo[4], hi[4];
+    PrincipalAxis(px, pw, 4, mean, axis);
+    AxisExtremes(px, pw, 4, mean, axis, lo, hi);
+
+    Bc7Try best;
+    best.err = FLT_MAX;
+    Bc7TryEndpoints(px, pw, lo, hi, &best);
+    for (int iter = 0; iter < 2; ++iter) {
+        float t[16], e0[4], e1[4];
+        for (int i = 0; i < 16; ++i) t[i] = kBc7W4[best.idx[i]] / 64.0f;
+        if (!LeastSquares(px, pw, t, 4, e0, e1)) break;
+        float before = best.err;
+        Bc7TryEndpoints(px, pw, e0, e1, &best);
+        if (best.err >= before) break;
+    }
+
+    // l'index du pixel 0 (ancre) est stocké sur 3 bits: son bit de poids fort doit être 0
+    if (best.idx[0] >= 8) {
+        for (int c = 0; c < 4; ++c) { int q = best.q0[c]; best.q0[c] = best.q1[c]; best.q1[c] = q; }
+        int p = best.p0; best.p0 = best.p1; best.p1 = p;
+        for (int i = 0; i < 16; ++i) best.idx[i] = (uint8_t)(15 - best.idx[i]);
+    }
+
+    memset(out, 0, 16);
+    BitWriter w = {out, 0};
+    PutBits(&w, 1u << 6, 7);   // mode 6
+    for (int c = 0; c < 4; ++c) { PutBits(&w, (uint32_t)best.q0[c], 7); PutBits(&w, (uint32_t)best.q1[c], 7); }
+    PutBits(&w, (uint32_t)best.p0, 1);
+    PutBits(&w, (uint32_t)best.p1, 1);
+    PutBits(&w, best.idx[0], 3);
+    for (int i = 1; i < 16; ++i) PutBits(&w, best.idx[i], 4);
+}
+
+static int DecodeBc7Block(const uint8_t in[16], uint8_t blk[16][4]) {
+    if ((in[0] & 0x7F) != 0x40) return -1;   // seul le mode 6 (celui qu'on produit) est décodé
+    int bit = 7, q0[4], q1[4];
+    for (int c = 0; c < 4; ++c) { q0[c] = (int)GetBits(in, &bit, 7); q1[c] = (int)GetBits(in, &bit, 7); }
+    int p0 = (int)GetBits(in, &bit, 1), p1 = (int)GetBits(in, &bit, 1);
+    float pal[16][4];
+    Bc7Palette(q0, q1, p0, p1, pal);
+    for (int i = 0; i < 16; ++i) {
+        int k = (int)GetBits(in, &bit, i == 0 ? 3 : 4);
+        for (int c = 0; c < 4; ++c) blk[i][c] = (uint8_t)pal[k][c];
+    }
+    return 0;
+}
+
+// ---------------- surfaces / threads ----------------
+typedef struct {
+    const uint8_t *rgba;
+    int w, h, format, blocksX, blocksY;
+    uint8_t *out;
+    atomic_int nextRow;
+} EncodeJob;
+
+static void EncodeRow(EncodeJob *j, int by) {
+    const int bb = BlockBytes(j->format);
+    uint8_t *dst = j->out + (size_t)by * j->blocksX * bb;
+    uint8_t blk[16][4];
+    for (int bx = 0; bx < j->blocksX; ++bx, dst += bb) {
+        LoadBlock(j->rgba, j->w, j->h, bx, by, blk);
+        switch (j->format) {
+            case BCENC_FORMAT_BC1: EncodeColorBlock(blk, 1, dst); break;
+            case BCENC_FORMAT_BC3: EncodeAlphaBlock(blk, dst); EncodeColorBlock(blk, 0, dst + 8); break;
+            default:               EncodeBc7Block(blk, dst); break;
+        }
+    }
+}
+
+static void *EncodeWorker(void *arg) {
+    EncodeJob *j = (EncodeJob *)arg;
+    for (;;) {
+        int by = atomic_fetch_add(&j->nextRow, 1);
+        if (by >= j->blocksY) break;
+        EncodeRow(j, by);
+    }
+    return NULL;
+}
+
+int bcenc_encode(const unsigned char *rgba, int width, int height, int format, unsigned char *out, int threads) {
+    if (!rgba || !out || width <= 0 || height <= 0) { bcenc_set_error("invalid arguments"); return -1; }
+    if (format != BCENC_FORMAT_BC1 && format != BCENC_FORMAT_BC3 && format != BCENC_FORMAT_BC7) {
+        bcenc_set_error("unsupported format %d", format);
+        return -1;
+    }
+    EncodeJob job = {rgba, width, height, format, (width + 3) / 4, (height + 3) / 4, out, 0};
+    atomic_init(&job.nextRow, 0);
+
+    int n = threads > 0 ? threads : CpuCount();
+    if (n > job.blocksY) n = job.blocksY;
+    if (n > 64) n = 64;
+    pthread_t tids[64];
+    int started = 0;
+    for (int i = 1; i < n; ++i)
+        if (pthread_create(&tids[started], NULL, EncodeWorker, &job) == 0) started++;
+    EncodeWorker(&job);   // le thread appelant travaille aussi
+    for (int i = 0; i < started; ++i) pthread_join(tids[i], NULL);
+    return 0;
+}
+
+int bcenc_decode(const unsigned char *blocks, int width, int height, int format, unsigned char *rgba) {
+    if (!blocks || !rgba || width <= 0 || height <= 0) { bcenc_set_error("invalid arguments"); return -1; }
+    const int bb = BlockBytes(format), bxN = (width + 3) / 4, byN = (height + 3) / 4;
+    uint8_t blk[16][4];
+    for (int by = 0; by < byN; ++by) {
+        for (int bx = 0; bx < bxN; ++bx) {
+            const uint8_t *src = blocks + ((size_t)by * bxN + bx) * bb;
+            switch (format) {
+                case BCENC_FORMAT_BC1: DecodeColorBlock(src, 1, blk); break;
+                case BCENC_FORMAT_BC3: DecodeColorBlock(src + 8, 0, blk); DecodeAlphaBlock(src, blk); break;
+                case BCENC_FORMAT_BC7:
+                    if (DecodeBc7Block(src, blk) != 0) { bcenc_set_error("BC7 block mode not supported by the decoder"); return -1; }
+                    break;
+                default: bcenc_set_error("unsupported format %d", format); return -1;
+            }
+            for (int y = 0; y < 4 && by * 4 + y < height; ++y)
+                for (int x = 0; x < 4 && bx * 4 + x < width; ++x)
+                    memcpy(rgba + ((size_t)(by * 4 + y) * width + bx * 4 + x) * 4, blk[y * 4 + x], 4);
+        }
+    }
+    return 0;
+}
+
+double bcenc_psnr(const unsigned char *a, const unsigned char *b, int width, int height, int channels) {
+    double se = 0.0;
+    size_t n = (size_t)width * height;
+    for (size_t i = 0; i < n; ++i)
+        for (int c = 0; c < channels; ++c) { double d = (double)a[i * 4 + c] - b[i * 4 + c]; se += d * d; }
+    if (se <= 0.0) return 99.0;
+    double mse = se / ((double)n * channels);
+    return 10.0 * log10(255.0 * 255.0 / mse);
+}
+
+double bcenc_psnr_premultiplied(const unsigned char *a, const unsigned char *b, int width, int height) {
+    double se = 0.0;
+    size_t n = (size_t)width * height;
+    for (size_t i = 0; i < n; ++i)
+        for (int c = 0; c < 3; ++c) {
+            double d = (a[i * 4 + c] * a[i * 4 + 3] - b[i * 4 + c] * b[i * 4 + 3]) / 255.0;
+            se += d * d;
+        }
+    if (se <= 0.0) return 99.0;
+    return 10.0 * log10(255.0 * 255.0 / (se / ((double)n * 3)));
+}
+
+// ---------------- mip chain / file conversion ----------------
+static uint8_t *Downsample(const uint8_t *src, int w, int h, int *ow, int *oh, int premultiplied) {
+    int nw = w > 1 ? w / 2 : 1, nh = h > 1 ? h / 2 : 1;
+    uint8_t *dst = (uint8_t *)malloc((size_t)nw * nh * 4);
+    if (!dst) return NULL;
+    for (int y = 0; y < nh; ++y) {
+        int y0 = ClampInt(y * 2, 0, h - 1), y1 = ClampInt(y * 2 + 1, 0, h - 1);
+        for (int x = 0; x < nw; ++x) {
+            int x0 = ClampInt(x * 2, 0, w - 1), x1 = ClampInt(x * 2 + 1, 0, w - 1);
+            const uint8_t *s[4] = {src + ((size_t)y0 * w + x0) * 4, src + ((size_t)y0 * w + x1) * 4,
+                                   src + ((size_t)y1 * w + x0) * 4, src + ((size_t)y1 * w + x1) * 4};
+            uint8_t *d = dst + ((size_t)y * nw + x) * 4;
+            int asum = s[0][3] + s[1][3] + s[2][3] + s[3][3];
+            for (int c = 0; c < 3; ++c) {
+                if (premultiplied || asum == 0) {
+                    d[c] = (uint8_t)((s[0][c] + s[1][c] + s[2][c] + s[3][c] + 2) / 4);
+                } else {
+                    // couleurs pondérées par l'alpha: pas de frange sombre autour des sprites
+                    int v = s[0][c] * s[0][3] + s[1][c] * s[1][3] + s[2][c] * s[2][3] + s[3][c] * s[3][3];
+                    d[c] = (uint8_t)((v + asum / 2) / asum);
+                }
+            }
+            d[3] = (uint8_t)((asum + 2) / 4);
+        }
+    }
+    *ow = nw;
+    *oh = nh;
+    return dst;
+}
+
+int bcenc_convert_file(const char *pngPath, const char *ddsPath, const char *format,
+                       int premultiply, int mipLevels, int threads) {
+    int fmt = bcenc_parse_format(format);
+    if (!fmt) { bcenc_set_error("unknown format '%s'", format ? format : "(null)"); return -1; }
+    int w = 0, h = 0;
+    uint8_t *rgba = bcenc_load_png(pngPath, &w, &h);
+    if (!rgba) return -1;
+
+    int hasAlpha = 0;
+    const size_t npx = (size_t)w * h;
+    for (size_t i = 0; i < npx; ++i) {
+        uint8_t *p = rgba + i * 4;
+        if (p[3] < 128) hasAlpha = 1;
+        if (premultiply && p[3] != 255) {
+            for (int c = 0; c < 3; ++c) p[c] = (uint8_t)((p[c] * p[3] + 127) / 255);
+        }
+    }
+
+    int maxLevels = 1;
+    for (int mw = w, mh = h; mw > 1 || mh > 1; mw = mw > 1 ? mw / 2 : 1, mh = mh > 1 ? mh / 2 : 1) maxLevels++;
+    int levels = (mipLevels <= 0 || mipLevels > maxLevels) ? maxLevels : mipLevels;
+
+    size_t total = 0;
+    for (int l = 0, mw = w, mh = h; l < levels; ++l, mw = mw > 1 ? mw / 2 : 1, mh = mh > 1 ? mh / 2 : 1)
+        total += bcenc_surface_size(fmt, mw, mh);
+    uint8_t *blocks = (uint8_t *)malloc(total);
+    if (!blocks) { free(rgba); bcenc_set_error("out of memory"); return -1; }
+
+    int rc = 0, lw = w, lh = h;
+    size_t off = 0;
+    uint8_t *level = rgba;
+    for (int l = 0; l < levels && rc == 0; ++l) {
+        rc = bcenc_encode(level, lw, lh, fmt, blocks + off, threads);
+        off += bcenc_surface_size(fmt, lw, lh);
+        if (l + 1 < levels) {
+            int nw, nh;
+            uint8_t *next = Downsample(level, lw, lh, &nw, &nh, premultiply);
+            if (level != rgba) free(level);
+            level = next;
+            lw = nw; lh = nh;
+            if (!level) { bcenc_set_error("out of memory"); rc = -1; }
+        }
+    }
+    if (level && level != rgba) free(level);
+    free(rgba);
+
+    if (rc == 0) rc = bcenc_write_dds(ddsPath, blocks, total, w, h, fmt, levels, premultiply, hasAlpha);
+    free(blocks);
+    return rc;
+}
@@ -0,0 +1,61 @@
+// bcenc.h — native BC1/BC3/BC7 encoder used by the pack pipeline (replaces texconv on Linux)
+#ifndef BCENC_H
+#define BCENC_H
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+    #define BCENC_API __declspec(dllexport)
+#else
+    #define BCENC_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Block formats (valeurs = numéro BCn)
+enum {
+    BCENC_FORMAT_NONE = 0,
+    BCENC_FORMAT_BC1  = 1,   // DXT1, 4 bpp, alpha 1 bit
+    BCENC_FORMAT_BC3  = 3,   // DXT5, 8 bpp
+    BCENC_FORMAT_BC7  = 7    // BC7 (mode 6), 8 bpp
+};
+
+// "BC1_UNORM", "DXT1", "BC3_UNORM", "DXT5", "BC7_UNORM"... -> BCENC_FORMAT_*, 0 si inconnu
+BCENC_API int bcenc_parse_format(const char *name);
+BCENC_API size_t bcenc_surface_size(int format, int width, int height);
+BCENC_API const char *bcenc_last_error(void);
+
+// rgba: width*height*4 octets (non prémultipliés sauf si l'appelant l'a fait).
+// threads <= 0 => nombre de coeurs. Retourne 0 si OK.
+BCENC_API int bcenc_encode(const unsigned char *rgba, int width, int height, int format,
+                           unsigned char *out, int threads);
+// Décodeur de contrôle (BC1/BC3 complets, BC7 mode 6 uniquement). Retourne 0 si OK.
+BCENC_API int bcenc_decode(const unsigned char *blocks, int width, int height, int format,
+                           unsigned char *rgba);
+// PSNR sur `channels` premiers canaux (3 = RGB, 4 = RGBA) ; 99.0 si identique
+BCENC_API double bcenc_psnr(const unsigned char *a, const unsigned char *b, int width, int height, int channels);
+// PSNR RGB après prémultiplication par l'alpha de chaque image (ignore la couleur des pixels invisibles)
+BCENC_API double bcenc_psnr_premultiplied(const unsigned char *a, const unsigned char *b, int width, int height);
+
+// Chaîne complète PNG -> DDS. mipLevels: 1 = pas de mips, 0 = chaîne complète.
+BCENC_API int bcenc_convert_file(const char *pngPath, const char *ddsPath, const char *format,
+                                 int premultiply, int mipLevels, int threads);
+
+// E/S (image_io.c). Les buffers retournés se libèrent avec bcenc_free().
+BCENC_API unsigned char *bcenc_load_png(const char *path, int *width, int *height);
+BCENC_API unsigned char *bcenc_load_dds(const char *path, int *width, int *height, int *format,
+                                        int *mipLevels, size_t *size);
+BCENC_API int bcenc_write_dds(const char *path, const unsigned char *data, size_t size, int width, int height,
+                              int format, int mipLevels, int premultiplied, int hasAlpha);
+BCENC_API void bcenc_free(void *p);
+
+// interne
+void bcenc_set_error(const char *fmt, ...);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BCENC_H
@@ -0,0 +1,277 @@
+// image_io.c — PNG reader (zlib) + DDS reader/writer for bcenc
+#include "bcenc.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <zlib.h>
+
+// ---------------- small utils ----------------
+static unsigned char *ReadWholeFile(const char *path, size_t *outSize) {
+    FILE *f = fopen(path, "rb");
+    if (!f) { bcenc_set_error("cannot open %s", path); return NULL; }
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (len <= 0) { fclose(f); bcenc_set_error("empty file %s", path); return NULL; }
+    unsigned char *buf = (unsigned char *)malloc((size_t)len);
+    if (!buf) { fclose(f); bcenc_set_error("out of memory"); return NULL; }
+    size_t rd = fread(buf, 1, (size_t)len, f);
+    fclose(f);
+    if (rd != (size_t)len) { free(buf); bcenc_set_error("short read on %s", path); return NULL; }
+    *outSize = (size_t)len;
+    return buf;
+}
+static uint32_t Be32(const unsigned char *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+static uint32_t Le32(const unsigned char *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+static void PutLe32(unsigned char *p, uint32_t v) {
+    p[0] = (unsigned char)v; p[1] = (unsigned char)(v >> 8); p[2] = (unsigned char)(v >> 16); p[3] = (unsigned char)(v >> 24);
+}
+
+// ---------------- PNG ----------------
+static int Paeth(int a, int b, int c) {
+    int p = a + b - c, pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+    if (pa <= pb && pa <= pc) return a;
+    return pb <= pc ? b : c;
+}
+
+// Lit une valeur d'échantillon (1..16 bits) et la ramène sur 8 bits
+static int Sample(const unsigned char *row, int i, int depth) {
+    switch (depth) {
+        case 8:  return row[i];
+        case 16: return row[i * 2];
+        default: {
+            int perByte = 8 / depth, shift = 8 - depth * (1 + i % perByte);
+            return (row[i / perByte] >> shift) & ((1 << depth) - 1);
+        }
+    }
+}
+
+unsigned char *bcenc_load_png(const char *path, int *width, int *height) {
+    static const unsigned char kSig[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+    size_t size = 0;
+    unsigned char *file = ReadWholeFile(path, &size);
+    if (!file) return NULL;
+    if (size < 8 || memcmp(file, kSig, 8) != 0) { free(file); bcenc_set_error("not a PNG: %s", path); return NULL; }
+
+    uint32_t w = 0, h = 0;
+    int depth = 0, ctype = 0, interlace = 0, palCount = 0;
+    unsigned char pal[256][4];
+    memset(pal, 255, sizeof(pal));
+    int trnsGray = -1, trnsRgb[3] = {-1, -1, -1};
+    unsigned char *idat = NULL;
+    size_t idatLen = 0;
+
+    for (size_t pos = 8; pos + 12 <= size;) {
+        uint32_t len = Be32(file + pos);
+        const unsigned char *type = file + pos + 4, *data = file + pos + 8;
+        if (pos + 12 + (size_t)len > size) break;
+        if (!memcmp(type, "IHDR", 4) && len >= 13) {
+            w = Be32(data); h = Be32(data + 4);
+            depth = data[8]; ctype = data[9]; interlace = data[12];
+        } else if (!memcmp(type, "PLTE", 4)) {
+            palCount = (int)(len / 3 > 256 ? 256 : len / 3);
+            for (int i = 0; i < palCount; ++i) { pal[i][0] = data[i * 3]; pal[i][1] = data[i * 3 + 1]; pal[i][2] = data[i * 3 + 2]; }
+        } else if (!memcmp(type, "tRNS", 4)) {
+            if (ctype == 3) for (uint32_t i = 0; i < len && i < 256; ++i) pal[i][3] = data[i];
+            else if (ctype == 0 && len >= 2) trnsGray = (data[0] << 8) | data[1];
+            else if (ctype == 2 && len >= 6) for (int c = 0; c < 3; ++c) trnsRgb[c] = (data[c * 2] << 8) | data[c * 2 + 1];
+        } else if (!memcmp(type, "IDAT", 4)) {
+            unsigned char *grown = (unsigned char *)realloc(idat, idatLen + len);
+            if (!grown) { free(idat); free(file); bcenc_set_error("out of memory"); return NULL; }
+            idat = grown;
+            memcpy(idat + idatLen, data, len);
+            idatLen += len;
+        } else if (!memcmp(type, "IEND", 4)) {
+            break;
+        }
+        pos += 12 + (size_t)len;
+    }
+    free(file);
+
+    const int channels = ctype == 0 ? 1 : ctype == 2 ? 3 : ctype == 3 ? 1 : ctype == 4 ? 2 : ctype == 6 ? 4 : 0;
+    if (!w || !h || !channels || !idat || interlace != 0 ||
+        !(depth == 8 || depth == 16 || (depth < 8 && (ctype == 0 || ctype == 3)))) {
+        free(idat);
+        bcenc_set_error("unsupported PNG (%ux%u type=%d depth=%d interlace=%d): %s", w, h, ctype, depth, interlace, path);
+        return NULL;
+    }
+
+    const size_t bpp = (size_t)((channels * depth + 7) / 8);        // octets par pixel (>= 1) pour les filtres
+    const size_t stride = ((size_t)w * channels * depth + 7) / 8;
+    const size_t rawLen = (stride + 1) * h;
+    unsigned char *raw = (unsigned char *)malloc(rawLen);
+    uLongf outLen = (uLongf)rawLen;
+    if (!raw || uncompress(raw, &outLen, idat, (uLong)idatLen) != Z_OK || outLen != rawLen) {
+        free(raw); free(idat);
+        bcenc_set_error("corrupt PNG data: %s", path);
+        return NULL;
+    }
+    free(idat);
+
+    // défiltrage en place
+    for (uint32_t y = 0; y < h; ++y) {
+        unsigned char *row = raw + y * (stride + 1) + 1;
+        const unsigned char *prev = y ? raw + (y - 1) * (stride + 1) + 1 : NULL;
+        int filter = row[-1];
+        for (size_t i = 0; i < stride; ++i) {
+            int a = i >= bpp ? row[i - bpp] : 0, b = prev ? prev[i] : 0, c = (prev && i >= bpp) ? prev[i - bpp] : 0;
+            switch (filter) {
+                case 1: row[i] = (unsigned char)(row[i] + a); break;
+                case 2: row[i] = (unsigned char)(row[i] + b); break;
+                case 3: row[i] = (unsigned char)(row[i] + ((a + b) >> 1)); break;
+                case 4: row[i] = (unsigned char)(row[i] + Paeth(a, b, c)); break;
+                default: break;
+            }
+        }
+    }
+
+    unsigned char *rgba = (unsigned char *)malloc((size_t)w * h * 4);
+    if (!rgba) { free(raw); bcenc_set_error("out of memory"); return NULL; }
+    const int maxv = (1 << (depth > 8 ? 8 : depth)) - 1;
+    for (uint32_t y = 0; y < h; ++y) {
+        const unsigned char *row = raw + y * (stride + 1) + 1;
+        unsigned char *dst = rgba + (size_t)y * w * 4;
+        for (uint32_t x = 0; x < w; ++x, dst += 4) {
+            switch (ctype) {
+                case 0: {
+                    int v = Sample(row, (int)x, depth);
+                    int full = depth == 16 ? ((row[x * 2] << 8) | row[x * 2 + 1]) : v;
+                    dst[0] = dst[1] = dst[2] = (unsigned char)(v * 255 / maxv);
+                    dst[3] = (full == trnsGray) ? 0 : 255;
+                } break;
+                case 3: {
+                    int i = Sample(row, (int)x, depth);
+                    memcpy(dst, pal[i], 4);
+                } break;
+                case 2: {
+                    int match = 1;
+                    for (int c = 0; c < 3; ++c) {
+                        dst[c] = (unsigned char)Sample(row, (int)x * 3 + c, depth);
+                        int full = depth == 16 ? ((row[(x * 3 + c) * 2] << 8) | row[(x * 3 + c) * 2 + 1]) : dst[c];
+                        if (full != trnsRgb[c]) match = 0;
+                    }
+                    dst[3] = match ? 0 : 255;
+                } break;
+                case 4:
+                    dst[0] = dst[1] = dst[2] = (unsigned char)Sample(row, (int)x * 2, depth);
+                    dst[3] = (unsigned char)Sample(row, (int)x * 2 + 1, depth);
+                    break;
+                default:
+                    for (int c = 0; c < 4; ++c) dst[c] = (unsigned char)Sample(row, (int)x * 4 + c, depth);
+                    break;
+            }
+        }
+    }
+    free(raw);
+    *width = (int)w;
+    *height = (int)h;
+    return rgba;
+}
+
+// ---------------- DDS ----------------
+#define DDSD_CAPS        0x1
+#define DDSD_HEIGHT      0x2
+#define DDSD_WIDTH       0x4
+#define DDSD_PIXELFORMAT 0x1000
+#define DDSD_MIPMAPCOUNT 0x20000
+#define DDSD_LINEARSIZE  0x80000
+#define DDPF_ALPHAPIXELS 0x1
+#define DDPF_FOURCC      0x4
+#define DDSCAPS_COMPLEX  0x8
+#define DDSCAPS_TEXTURE  0x1000
+#define DDSCAPS_MIPMAP   0x400000
+#define DXGI_FORMAT_BC1_UNORM 71
+#define DXGI_FORMAT_BC3_UNORM 77
+#define DXGI_FORMAT_BC7_UNORM 98
+#define FOURCC(a, b, c, d) ((uint32_t)(a) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+
+int bcenc_write_dds(const char *path, const unsigned char *data, size_t size, int width, int height,
+                    int format, int mipLevels, int premultiplied, int hasAlpha) {
+    unsigned char hdr[4 + 124 + 20];
+    memset(hdr, 0, sizeof(hdr));
+    memcpy(hdr, "DDS ", 4);
+    unsigned char *h = hdr + 4;
+    uint32_t flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_LINEARSIZE;
+    if (mipLevels > 1) flags |= DDSD_MIPMAPCOUNT;
+    PutLe32(h + 0, 124);
+    PutLe32(h + 4, flags);
+    PutLe32(h + 8, (uint32_t)height);
+    PutLe32(h + 12, (uint32_t)width);
+    PutLe32(h + 16, (uint32_t)bcenc_surface_size(format, width, height));
+    PutLe32(h + 24, (uint32_t)(mipLevels > 1 ? mipLevels : 1));
+    // DDS_PIXELFORMAT @ 72
+    PutLe32(h + 72, 32);
+    size_t hdrLen = 4 + 124;
+    switch (format) {
+        case BCENC_FORMAT_BC1:
+            // ALPHAPIXELS => raylib choisit DXT1_RGBA (index 3 = transparent)
+            PutLe32(h + 76, DDPF_FOURCC | (hasAlpha ? DDPF_ALPHAPIXELS : 0));
+            PutLe32(h + 80, FOURCC('D', 'X', 'T', '1'));
+            break;
+        case BCENC_FORMAT_BC3:
+            PutLe32(h + 76, DDPF_FOURCC);
+            PutLe32(h + 80, FOURCC('D', 'X', 'T', '5'));
+            break;
+        case BCENC_FORMAT_BC7: {
+            PutLe32(h + 76, DDPF_FOURCC);
+            PutLe32(h + 80, FOURCC('D', 'X', '1', '0'));
+            unsigned char *dx10 = hdr + 4 + 124;
+            PutLe32(dx10 + 0, DXGI_FORMAT_BC7_UNORM);
+            PutLe32(dx10 + 4, 3);      // D3D10_RESOURCE_DIMENSION_TEXTURE2D
+            PutLe32(dx10 + 8, 0);
+            PutLe32(dx10 + 12, 1);     // arraySize
+            PutLe32(dx10 + 16, premultiplied ? 2 : 1);   // DDS_ALPHA_MODE_PREMULTIPLIED / STRAIGHT
+            hdrLen += 20;
+        } break;
+        default:
+            bcenc_set_error("unsupported format %d", format);
+            return -1;
+    }
+    PutLe32(h + 104, DDSCAPS_TEXTURE | (mipLevels > 1 ? (DDSCAPS_COMPLEX | DDSCAPS_MIPMAP) : 0));
+
+    FILE *f = fopen(path, "wb");
+    if (!f) { bcenc_set_error("cannot write %s", path); return -1; }
+    int ok = fwrite(hdr, 1, hdrLen, f) == hdrLen && fwrite(data, 1, size, f) == size;
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) { bcenc_set_error("write failed: %s", path); return -1; }
+    return 0;
+}
+
+unsigned char *bcenc_load_dds(const char *path, int *width, int *height, int *format, int *mipLevels, size_t *size) {
+    size_t len = 0;
+    unsigned char *file = ReadWholeFile(path, &len);
+    if (!file) return NULL;
+    if (len < 128 || memcmp(file, "DDS ", 4) != 0) { free(file); bcenc_set_error("not a DDS: %s", path); return NULL; }
+    const unsigned char *h = file + 4;
+    size_t off = 128;
+    int fmt = BCENC_FORMAT_NONE;
+    uint32_t fourcc = Le32(h + 80);
+    if (fourcc == FOURCC('D', 'X', 'T', '1')) fmt = BCENC_FORMAT_BC1;
+    else if (fourcc == FOURCC('D', 'X', 'T', '5')) fmt = BCENC_FORMAT_BC3;
+    else if (fourcc == FOURCC('D', 'X', '1', '0') && len >= 148) {
+        uint32_t dxgi = Le32(file + 128);
+        off = 148;
+        if (dxgi == DXGI_FORMAT_BC1_UNORM || dxgi == DXGI_FORMAT_BC1_UNORM + 1) fmt = BCENC_FORMAT_BC1;
+        else if (dxgi == DXGI_FORMAT_BC3_UNORM || dxgi == DXGI_FORMAT_BC3_UNORM + 1) fmt = BCENC_FORMAT_BC3;
+        else if (dxgi == DXGI_FORMAT_BC7_UNORM || dxgi == DXGI_FORMAT_BC7_UNORM + 1) fmt = BCENC_FORMAT_BC7;
+    }
+    if (!fmt) { free(file); bcenc_set_error("unsupported DDS pixel format: %s", path); return NULL; }
+
+    size_t n = len - off;
+    unsigned char *out = (unsigned char *)malloc(n ? n : 1);
+    if (!out) { free(file); bcenc_set_error("out of memory"); return NULL; }
+    memcpy(out, file + off, n);
+    if (width) *width = (int)Le32(h + 12);
+    if (height) *height = (int)Le32(h + 8);
+    if (format) *format = fmt;
+    if (mipLevels) { uint32_t m = Le32(h + 24); *mipLevels = m ? (int)m : 1; }
+    if (size) *size = n;
+    free(file);
+    return out;
+}
@@ -0,0 +1,70 @@
+// main.c — bcenc CLI. Accepte le sous-ensemble d'options texconv utilisé par convert_and_pack.py:
+//   bcenc -f BC3_UNORM [-o outdir] [-pmalpha] [-m N] [-t threads] [-nologo] [-y] file.png [...]
+// Sortie: <outdir>/<basename>.dds
+#include "bcenc.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static void Usage(void) {
+    fprintf(stderr,
+            "usage: bcenc -f <BC1_UNORM|BC3_UNORM|BC7_UNORM|DXT1|DXT5> [-o outdir] [-pmalpha]\n"
+            "             [-m mips (0 = full chain, 1 = none)] [-t threads] [-y] [-nologo] file.png...\n");
+}
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+    const char *format = "BC3_UNORM";
+    const char *outDir = NULL;
+    int premul = 0, mips = 0, threads = 0, quiet = 0, files = 0, failures = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *a = argv[i];
+        if (!strcmp(a, "-f") && i + 1 < argc) format = argv[++i];
+        else if (!strcmp(a, "-o") && i + 1 < argc) outDir = argv[++i];
+        else if (!strcmp(a, "-m") && i + 1 < argc) mips = atoi(argv[++i]);
+        else if (!strcmp(a, "-t") && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (!strcmp(a, "-pmalpha")) premul = 1;
+        else if (!strcmp(a, "-nologo")) quiet = 1;
+        else if (!strcmp(a, "-y")) { /* on écrase toujours */ }
+        else if (!strcmp(a, "-h") || !strcmp(a, "--help")) { Usage(); return 0; }
+        else if (a[0] == '-') { fprintf(stderr, "unknown option: %s\n", a); Usage(); return 2; }
+    }
+    if (!bcenc_parse_format(format)) { fprintf(stderr, "unsupported format: %s\n", format); return 2; }
+    if (!quiet) printf("bcenc — BC1/BC3/BC7 block encoder\n");
+
+    for (int i = 1; i < argc; ++i) {
+        const char *a = argv[i];
+        if (a[0] == '-') {
+            if (!strcmp(a, "-f") || !strcmp(a, "-o") || !strcmp(a, "-m") || !strcmp(a, "-t")) ++i;
+            continue;
+        }
+        files++;
+
+        // <outdir>/<basename sans extension>.dds
+        const char *base = a;
+        for (const char *p = a; *p; ++p) if (*p == '/' || *p == '\\') base = p + 1;
+        const char *dot = strrchr(base, '.');
+        size_t stem = dot ? (size_t)(dot - base) : strlen(base);
+        char out[1024];
+        if (outDir) snprintf(out, sizeof(out), "%s/%.*s.dds", outDir, (int)stem, base);
+        else        snprintf(out, sizeof(out), "%.*s%.*s.dds", (int)(base - a), a, (int)stem, base);
+
+        double t0 = NowSeconds();
+        if (bcenc_convert_file(a, out, format, premul, mips, threads) != 0) {
+            fprintf(stderr, "FAILED %s: %s\n", a, bcenc_last_error());
+            failures++;
+            continue;
+        }
+        if (!quiet) printf("writing %s (%.1f ms)\n", out, (NowSeconds() - t0) * 1000.0);
+    }
+    if (!files) { Usage(); return 2; }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+# Rapport d'occupation des atlas: parcourt les .pak d'un dossier (ceux que le viewer monte, cf.
+# MountAllPaksInCwd / ListPakContents) et mesure, pour chaque pack (.json / .swfb dans un pak):
+#   - pages: nombre, format, mips, VRAM estimée au chargement (mips comprises, palette PAL8 comprise)
+#   - couverture: part de chaque page sous au moins une rect de frame (tuiles comprises)
+#   - transparence: part des px couverts dont l'alpha est nul (trim/maillage à revoir)
+#   - rects dupliquées: rects distinctes au contenu identique (dédup manquée, place payée deux fois)
+#   python atlas_report.py paks/ --csv report.csv --json report.json --top 20
+# Classement par VRAM gaspillée = VRAM x (1 - px utiles / px de la page), px utiles = couverts et non
+# transparents. Sans libbcenc, les pages BC ne sont pas décodées: transparence et doublons manquent.
+import argparse, csv, hashlib, json, struct, sys, tempfile
+from collections import Counter
+from pathlib import Path
+from zipfile import ZipFile, BadZipFile
+
+import bcenc
+import pal8
+import pngio
+import swfmeta
+from convert_and_pack import page_rects
+
+DDS_HEADER = 128
+DDS_DX10_HEADER = 20
+FOURCC_LABELS = {b"DXT1": "BC1", b"DXT5": "BC3", b"DX10": "BC7"}
+
+# ---------------- pages ----------------
+def _bc_labels() -> dict:
+    if not bcenc.available():
+        return {}
+    return {bcenc.parse_format(n): label for n, label in (("BC1_UNORM", "BC1"), ("BC3_UNORM", "BC3"), ("BC7_UNORM", "BC7"))}
+
+def load_page(path: Path, hint: str) -> dict:
+    """-> {w, h, format, mips, vram, px, bpp, alpha}; px/alpha None si la page n'est pas décodable ici"""
+    ext = path.suffix.lower()
+    if ext == ".png":
+        w, h, rgba = bcenc.load_png(path) if bcenc.available() else pngio.read_png(path)
+        return dict(w=w, h=h, format=hint or "RGBA8", mips=1, vram=w * h * 4, px=bytes(rgba), bpp=4, alpha=bytes(rgba[3::4]))
+    if pal8.is_pal8_dds(path):
+        w, h, palette, index = pal8.read_dds(path)
+        # index 8 bits: le contenu se compare sur les index, l'alpha se lit dans la palette
+        alpha_lut = bytes(palette[i * 4 + 3] for i in range(256))
+        return dict(w=w, h=h, format="PAL8", mips=1, vram=w * h + len(palette), px=index, bpp=1,
+                    alpha=index.translate(alpha_lut))
+    if bcenc.available():
+        try:
+            w, h, fmt, mips, blocks = bcenc.load_dds(path)
+            rgba = bcenc.decode(blocks, w, h, fmt)
+            return dict(w=w, h=h, format=hint or _bc_labels().get(fmt, str(fmt)), mips=mips, vram=len(blocks),
+                        px=rgba, bpp=4, alpha=rgba[3::4])
+        except RuntimeError as e:
+            # blocs que le décodeur ne gère pas (ex. BC7 texconv hors mode 6): la page reste comptée
+            print(f"[warn] {path.name}: not decoded ({e}), header only", file=sys.stderr)
+    # en-tête seul: dimensions, mips et taille des blocs
+    head = path.read_bytes()[:DDS_HEADER + DDS_DX10_HEADER]
+    h, w = struct.unpack_from("<II", head, 12)
+    mips = max(1, struct.unpack_from("<I", head, 28)[0])
+    fourcc = head[84:88]
+    header = DDS_HEADER + (DDS_DX10_HEADER if fourcc == b"DX10" else 0)
+    return dict(w=w, h=h, format=hint or FOURCC_LABELS.get(fourcc, fourcc.decode("ascii", "replace")), mips=mips,
+                vram=path.stat().st_size - header, px=None, bpp=0, alpha=None)
+
+def covered_spans(rects, w: int, h: int) -> dict:
+    # y -> intervalles [x0, x1) fusionnés: l'union des rects, rects qui se chevauchent comprises
+    rows = {}
+    for x, y, rw, rh in rects:
+        x0, x1 = max(0, x), min(w, x + rw)
+        if x0 >= x1:
+            continue
+        for yy in range(max(0, y), min(h, y + rh)):
+            rows.setdefault(yy, []).append((x0, x1))
+    for yy, spans in rows.items():
+        spans.sort()
+        merged = [list(spans[0])]
+        for a, b in spans[1:]:
+            if a <= merged[-1][1]:
+                merged[-1][1] = max(merged[-1][1], b)
+            else:
+                merged.append([a, b])
+        rows[yy] = merged
+    return rows
+
+def duplicate_rects(rects, page: dict) -> int:
+    # rects distinctes (page_rects a déjà fusionné les frames qui partagent une rect) au contenu identique
+    w, bpp, px = page["w"], page["bpp"], page["px"]
+    seen, dups = set(), 0
+    for x, y, rw, rh in rects:
+        if x < 0 or y < 0 or x + rw > w or y + rh > page["h"]:
+            continue
+        hsh = hashlib.sha1(struct.pack("<II", rw, rh))
+        for r in range(rh):
+            o = ((y + r) * w + x) * bpp
+            hsh.update(px[o:o + rw * bpp])
+        key = hsh.digest()
+        dups += key in seen
+        seen.add(key)
+    return dups
+
+def page_report(ref: str, page: dict, rects) -> dict:
+    w, h = page["w"], page["h"]
+    covered, clear = 0, 0
+    for y, spans in covered_spans(rects, w, h).items():
+        for x0, x1 in spans:
+            covered += x1 - x0
+            if page["alpha"] is not None:
+                clear += page["alpha"][y * w + x0:y * w + x1].count(0)
+    known = page["alpha"] is not None
+    useful = covered - clear
+    return {
+        "page": ref, "format": page["format"], "w": w, "h": h, "mips": page["mips"],
+        "rects": len(rects), "coverage_pct": round(100.0 * covered / max(1, w * h), 2),
+        "transparent_in_rects_pct": round(100.0 * clear / max(1, covered), 2) if known else None,
+        "duplicate_rects": duplicate_rects(rects, page) if known else None,
+        "vram_bytes": page["vram"], "wasted_bytes": int(page["vram"] * (1.0 - useful / max(1, w * h))),
+    }
+
+# ---------------- packs ----------------
+def pack_frames(meta: dict) -> int:
+    return sum(len(sym.get("frames") or []) for sym in meta.get("symbols") or [])
+
+def report_pack(zf: ZipFile, meta_name: str, tmp: Path) -> dict:
+    raw = zf.read(meta_name)
+    meta = swfmeta.decode(raw) if meta_name.lower().endswith(".swfb") else json.loads(raw.decode("utf-8"))
+    global_rects, sym_rects = page_rects(meta)
+    names = set(zf.namelist())
+
+    # pages globales puis pages propres aux symboles (mode perSymbol), chacune avec ses rects
+    groups = [(meta.get("pages") or [], meta.get("pageFormats") or [], global_rects)]
+    for sym, own in zip(meta.get("symbols") or [], sym_rects):
+        if isinstance(sym.get("pages"), list):
+            groups.append((sym["pages"], sym.get("pageFormats") or [], own))
+
+    pages, missing = [], []
+    for refs, formats, rects_by_page in groups:
+        for i, ref in enumerate(refs):
+            if ref not in names:
+                missing.append(ref)
+                continue
+            hint = formats[i] if i < len(formats) else None
+            page = load_page(Path(zf.extract(ref, tmp)), hint)
+            pages.append(page_report(ref, page, sorted(rects_by_page.get(i, ()))))
+
+    area = sum(p["w"] * p["h"] for p in pages)
+    covered = sum(p["coverage_pct"] * p["w"] * p["h"] / 100.0 for p in pages)
+    decoded = [p for p in pages if p["transparent_in_rects_pct"] is not None]
+    dec_covered = sum(p["coverage_pct"] * p["w"] * p["h"] / 100.0 for p in decoded)
+    clear = sum(p["transparent_in_rects_pct"] * p["coverage_pct"] * p["w"] * p["h"] / 1e4 for p in decoded)
+    return {
+        "pack": meta.get("swf") or Path(meta_name).stem,
+        "meta": meta_name,
+        "pages": len(pages),
+        "formats": " ".join(f"{k}x{n}" for k, n in sorted(Counter(p["format"] for p in pages).items())),
+        "frames": pack_frames(meta),
+        "rects": sum(p["rects"] for p in pages),
+        "coverage_pct": round(100.0 * covered / max(1, area), 2),
+        "transparent_in_rects_pct": round(100.0 * clear / max(1, dec_covered), 2) if decoded else None,
+        "duplicate_rects": sum(p["duplicate_rects"] for p in decoded) if decoded else None,
+        "vram_bytes": sum(p["vram_bytes"] for p in pages),
+        "wasted_bytes": sum(p["wasted_bytes"] for p in pages),
+        "missing_pages": missing,
+        "page_details": pages,
+    }
+
+def report_paks(pak_dir: Path) -> list:
+    out = []
+    for pak in sorted(pak_dir.glob("*.pak")):
+        try:
+            with ZipFile(pak) as zf, tempfile.TemporaryDirectory() as tmp:
+                for name in sorted(n for n in zf.namelist() if swfmeta.is_meta_file(Path(n))):
+                    row = report_pack(zf, name, Path(tmp))
+                    row["pak"] = pak.name
+                    out.append(row)
+        except BadZipFile:
+            print(f"[warn] {pak.name}: not a zip, skipped", file=sys.stderr)
+    out.sort(key=lambda r: r["wasted_bytes"], reverse=True)
+    return out
+
+CSV_COLUMNS = ["pak", "pack", "pages", "formats", "frames", "rects", "coverage_pct", "transparent_in_rects_pct",
+               "duplicate_rects", "vram_bytes", "wasted_bytes"]
+
+def write_csv(path: Path, rows: list):
+    with open(path, "w", newline="", encoding="utf-8") as fp:
+        wr = csv.DictWriter(fp, fieldnames=CSV_COLUMNS, extrasaction="ignore")
+        wr.writeheader()
+        for r in rows:
+            wr.writerow({k: "" if r.get(k) is None else r[k] for k in CSV_COLUMNS})
+
+def main():
+    ap = argparse.ArgumentParser(description="Atlas occupancy / waste report over every .pak in a directory")
+    ap.add_argument("pak_dir", nargs="?", default=".", help="Directory holding the .pak files (default: cwd, like the viewer)")
+    ap.add_argument("--csv", default=None, help="One row per pack, ranked by wasted VRAM")
+    ap.add_argument("--json", default=None, help="Same ranking with per-page details")
+    ap.add_argument("--top", type=int, default=20, help="Packs printed to stdout")
+    a = ap.parse_args()
+
+    if not bcenc.available():
+        print("[warn] libbcenc not found: BC pages are not decoded (no transparency / duplicate figures)", file=sys.stderr)
+    rows = report_paks(Path(a.pak_dir))
+    if not rows:
+        raise SystemExit(f"No pack metadata in {a.pak_dir}/*.pak")
+    if a.csv:
+        write_csv(Path(a.csv), rows)
+    if a.json:
+        Path(a.json).write_text(json.dumps(rows, indent=2), encoding="utf-8")
+
+    mb = 1024.0 * 1024.0
+    print(f"{'pack':32} {'pages':>5} {'cover%':>7} {'clear%':>7} {'dups':>5} {'VRAM MB':>8} {'waste MB':>8}  formats")
+    for r in rows[:a.top]:
+        clear = "-" if r["transparent_in_rects_pct"] is None else f"{r['transparent_in_rects_pct']:.1f}"
+        dups = "-" if r["duplicate_rects"] is None else r["duplicate_rects"]
+        print(f"{r['pack'][:32]:32} {r['pages']:5} {r['coverage_pct']:7.1f} {clear:>7} {dups!s:>5} "
+              f"{r['vram_bytes'] / mb:8.2f} {r['wasted_bytes'] / mb:8.2f}  {r['formats']}")
+    total, wasted = sum(r["vram_bytes"] for r in rows), sum(r["wasted_bytes"] for r in rows)
+    print(f"{len(rows)} packs, {total / mb:.1f} MB VRAM, {wasted / mb:.1f} MB wasted ({100.0 * wasted / max(1, total):.0f}%)")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+# Binding ctypes vers libbcenc (../bc-encoder) : encodeur BC1/BC3/BC7 natif, utilisé à la place
+# de texconv.exe sous Linux par convert_and_pack.py
+import ctypes, os, sys
+from pathlib import Path
+
+HERE = Path(__file__).resolve().parent
+
+def _candidates():
+    env = os.environ.get("BCENC_LIB")
+    if env:
+        yield Path(env)
+    names = ["bcenc.dll", "libbcenc.dll"] if sys.platform == "win32" else \
+            ["libbcenc.dylib"] if sys.platform == "darwin" else ["libbcenc.so"]
+    for d in [HERE, HERE.parent / "bc-encoder" / "build", HERE.parent / "bc-encoder" / "cmake-build-release",
+              HERE.parent / "bc-encoder"]:
+        for n in names:
+            yield d / n
+
+_lib = None
+
+def load():
+    """Charge la bibliothèque (une seule fois). Retourne None si introuvable."""
+    global _lib
+    if _lib is not None:
+        return _lib or None
+    for p in _candidates():
+        if p.exists():
+            try:
+                lib = ctypes.CDLL(str(p))
+            except OSError:
+                continue
+            _declare(lib)
+            _lib = lib
+            return lib
+    _lib = False
+    return None
+
+def available() -> bool:
+    return load() is not None
+
+def _declare(lib):
+    c_ubyte_p = ctypes.POINTER(ctypes.c_ubyte)
+    lib.bcenc_parse_format.argtypes = [ctypes.c_char_p]
+    lib.bcenc_parse_format.restype = ctypes.c_int
+    lib.bcenc_surface_size.argtypes = [ctypes.c_int, ctypes.c_int, ctypes.c_int]
+    lib.bcenc_surface_size.restype = ctypes.c_size_t
+    lib.bcenc_last_error.restype = ctypes.c_char_p
+    lib.bcenc_encode.argtypes = [ctypes.c_char_p, ctypes.c_int, ctypes.c_int, ctypes.c_int, ctypes.c_char_p, ctypes.c_int]
+    lib.bcenc_decode.argtypes = [ctypes.c_char_p, ctypes.c_int, ctypes.c_int, ctypes.c_int, ctypes.c_char_p]
+    lib.bcenc_psnr.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int, ctypes.c_int, ctypes.c_int]
+    lib.bcenc_psnr.restype = ctypes.c_double
+    lib.bcenc_psnr_premultiplied.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int, ctypes.c_int]
+    lib.bcenc_psnr_premultiplied.restype = ctypes.c_double
+    lib.bcenc_convert_file.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int, ctypes.c_int, ctypes.c_int]
+    lib.bcenc_load_png.argtypes = [ctypes.c_char_p, ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.c_int)]
+    lib.bcenc_load_png.restype = c_ubyte_p
+    lib.bcenc_load_dds.argtypes = [ctypes.c_char_p, ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.c_int),
+                                   ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.c_size_t)]
+    lib.bcenc_load_dds.restype = c_ubyte_p
+    lib.bcenc_free.argtypes = [ctypes.c_void_p]
+
+def _require():
+    lib = load()
+    if lib is None:
+        raise RuntimeError("libbcenc not found (build bc-encoder/ or set BCENC_LIB)")
+    return lib
+
+def _check(rc: int):
+    if rc != 0:
+        raise RuntimeError("bcenc: " + _require().bcenc_last_error().decode("utf-8", "replace"))
+
+def parse_format(name: str) -> int:
+    return _require().bcenc_parse_format(name.encode())
+
+def convert_file(png_path: Path, dds_path: Path, fmt: str, premul: bool, mip_levels: int = 1, threads: int = 0):
+    """PNG -> DDS. mip_levels: 1 = pas de mips, 0 = chaîne complète."""
+    lib = _require()
+    _check(lib.bcenc_convert_file(str(png_path).encode(), str(dds_path).encode(), fmt.encode(),
+                                  int(premul), int(mip_levels), int(threads)))
+
+def load_png(path: Path):
+    """-> (width, height, bytes RGBA8)"""
+    lib = _require()
+    w, h = ctypes.c_int(), ctypes.c_int()
+    p = lib.bcenc_load_png(str(path).encode(), ctypes.byref(w), ctypes.byref(h))
+    if not p:
+        _check(-1)
+    try:
+        return w.value, h.value, ctypes.string_at(p, w.value * h.value * 4)
+    finally:
+        lib.bcenc_free(p)
+
+def load_dds(path: Path):
+    """-> (width, height, format, mip levels, bytes des blocs)"""
+    lib = _require()
+    w, h, f, m, n = ctypes.c_int(), ctypes.c_int(), ctypes.c_int(), ctypes.c_int(), ctypes.c_size_t()
+    p = lib.bcenc_load_dds(str(path).encode(), ctypes.byref(w), ctypes.byref(h), ctypes.byref(f), ctypes.byref(m), ctypes.byref(n))
+    if not p:
+        _check(-1)
+    try:
+        return w.value, h.value, f.value, m.value, ctypes.string_at(p, n.value)
+    finally:
+        lib.bcenc_free(p)
+
+def encode(rgba: bytes, w: int, h: int, fmt, threads: int = 0) -> bytes:
+    lib = _require()
+    f = fmt if isinstance(fmt, int) else parse_format(fmt)
+    out = ctypes.create_string_buffer(lib.bcenc_surface_size(f, w, h))
+    _check(lib.bcenc_encode(rgba, w, h, f, out, threads))
+    return out.raw
+
+def decode(blocks: bytes, w: int, h: int, fmt) -> bytes:
+    lib = _require()
+    f = fmt if isinstance(fmt, int) else parse_format(fmt)
+    out = ctypes.create_string_buffer(w * h * 4)
+    _check(lib.bcenc_decode(blocks, w, h, f, out))
+    return out.raw
+
+def psnr(a: bytes, b: bytes, w: int, h: int, channels: int = 4) -> float:
+    return _require().bcenc_psnr(a, b, w, h, channels)
+
+def psnr_premultiplied(a: bytes, b: bytes, w: int, h: int) -> float:
+    return _require().bcenc_psnr_premultiplied(a, b, w, h)
+
+if __name__ == "__main__":
+    print("libbcenc:", "found" if available() else "NOT found")
@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+# Benchmark bc-encoder (natif) vs texconv (référence): débit (MPix/s) et PSNR par format.
+#   python bench_bcenc.py atlas_0.png atlas_1.png --formats BC1_UNORM,BC3_UNORM,BC7_UNORM
+# La référence n'est mesurée que si texconv est disponible (--texconv ou PATH).
+# Alpha droit des deux côtés; "PSNR rgb" compare les couleurs pondérées par l'alpha.
+import argparse, shutil, subprocess, tempfile, time
+from pathlib import Path
+
+import bcenc
+
+def decode_dds(dds: Path, texconv: str, tmp: Path):
+    w, h, fmt, _, blocks = bcenc.load_dds(dds)
+    try:
+        return w, h, bcenc.decode(blocks, w, h, fmt)
+    except RuntimeError:
+        # BC7 multi-modes (texconv): on laisse texconv le décompresser en PNG
+        if not texconv:
+            raise
+        out = tmp / "decoded"
+        out.mkdir(exist_ok=True)
+        subprocess.check_call([texconv, "-nologo", "-y", "-ft", "png", "-f", "R8G8B8A8_UNORM", "-o", str(out), str(dds)],
+                              stdout=subprocess.DEVNULL)
+        w, h, px = bcenc.load_png(out / (dds.stem + ".png"))
+        return w, h, px
+
+def measure(name, encode, png: Path, dds: Path, src, texconv, tmp, runs):
+    w, h, px = src
+    best = float("inf")
+    for _ in range(runs):
+        t0 = time.perf_counter()
+        encode()
+        best = min(best, time.perf_counter() - t0)
+    _, _, dec = decode_dds(dds, texconv, tmp)
+    return {
+        "encoder": name,
+        "mpix_s": w * h / best / 1e6,
+        "ms": best * 1000.0,
+        "psnr_rgb": bcenc.psnr_premultiplied(px, dec, w, h),
+        "psnr_rgba": bcenc.psnr(px, dec, w, h, 4),
+        "size": dds.stat().st_size,
+    }
+
+def main():
+    ap = argparse.ArgumentParser(description="Throughput / PSNR benchmark: bc-encoder vs texconv")
+    ap.add_argument("images", nargs="+", help="PNG pages to encode")
+    ap.add_argument("--formats", default="BC1_UNORM,BC3_UNORM,BC7_UNORM")
+    ap.add_argument("--threads", type=int, default=0, help="bc-encoder threads (0 = all cores)")
+    ap.add_argument("--runs", type=int, default=3, help="Best of N runs")
+    ap.add_argument("--texconv", default=shutil.which("texconv"), help="Reference texconv executable")
+    args = ap.parse_args()
+
+    if not bcenc.available():
+        raise SystemExit("libbcenc not found: build bc-encoder/ (cmake) or set BCENC_LIB")
+
+    print(f"{'image':24} {'format':10} {'encoder':8} {'MPix/s':>8} {'ms':>9} {'PSNR rgb':>9} {'PSNR rgba':>10} {'bytes':>9}")
+    with tempfile.TemporaryDirectory() as td:
+        tmp = Path(td)
+        for img in map(Path, args.images):
+            src = bcenc.load_png(img)
+            for fmt in args.formats.split(","):
+                rows = []
+                dds = tmp / f"{img.stem}.dds"
+                rows.append(measure("bcenc", lambda: bcenc.convert_file(img, dds, fmt, False, 1, args.threads),
+                                    img, dds, src, args.texconv, tmp, args.runs))
+                if args.texconv:
+                    ref_dir = tmp / "ref"
+                    ref_dir.mkdir(exist_ok=True)
+                    cmd = [args.texconv, "-nologo", "-y", "-f", fmt, "-m", "1", "-o", str(ref_dir), str(img)]
+                    ref = ref_dir / (img.stem + ".DDS")
+                    run = lambda: subprocess.check_call(cmd, stdout=subprocess.DEVNULL)
+                    run()
+                    if not ref.exists():
+                        ref = ref_dir / (img.stem + ".dds")
+                    rows.append(measure("texconv", run, img, ref, src, args.texconv, tmp, args.runs))
+                for r in rows:
+                    print(f"{img.name[:24]:24} {fmt:10} {r['encoder']:8} {r['mpix_s']:8.2f} {r['ms']:9.1f} "
+                          f"{r['psnr_rgb']:9.2f} {r['psnr_rgba']:10.2f} {r['size']:9d}")
+
+if __name__ == "__main__":
+    main()
@@ -1,15 +1,152 @@
 #!/usr/bin/env python3
-import argparse, subprocess, shutil, json
+import argparse, subprocess, shutil, json, hashlib, struct, zlib, os, sys
+from concurrent.futures import ThreadPoolExecutor
 from pathlib import Path
-from zipfile import ZipFile, ZIP_DEFLATED
+from zipfile import ZipFile, ZIP_DEFLATED, BadZipFile
+
+import bcenc
+import pal8
+import pngio
+import swfmeta
 
 # --- Réglages DDS / texconv ---
 TEXCONV_EXE = shutil.which("texconv") or "texconv"
-DEFAULT_FORMAT = "DXT5"   # alternatives utiles: "DXT5", "BC3_UNORM"
+DEFAULT_FORMAT = "auto"   # "auto" (BC1 si la page le supporte, sinon AUTO_ALPHA_FORMAT), "DXT5", "BC3_UNORM", "BC7_UNORM"...
+AUTO_ALPHA_FORMAT = "BC3_UNORM"   # format des pages dont l'alpha ne tient pas en BC1 (BC3_UNORM ou BC7_UNORM)
+AUTO_QUALITY_DB = 38.0            # PSNR mini (couleurs prémultipliées) pour accepter BC1 sur une page avec alpha
+# Pages d'aplats: index 8 bits + palette 256 couleurs (DDS P8, "PAL8") quand la page tient en 256
+# couleurs à PALETTE_QUALITY_DB près, sinon repli sur le format BC choisi ci-dessus
+PALETTE_PAGES = False
+PALETTE_QUALITY_DB = 45.0
 PREMULTIPLY_ALPHA = False
 GEN_MIPMAPS = False            # True si tu veux des mipmaps
+# "native" = bc-encoder (libbcenc via ctypes), défaut sous Linux ; "texconv" = DirectXTex
+ENCODER = "auto"
+
+def resolve_encoder(name: str) -> str:
+    if name == "auto":
+        return "native" if sys.platform != "win32" and bcenc.available() else "texconv"
+    if name == "native" and not bcenc.available():
+        raise SystemExit("libbcenc not found: build bc-encoder/ (cmake) or set BCENC_LIB")
+    return name
+
+# --- Build incrémental ---
+MANIFEST_VERSION = 1
+ZIP_LEVEL = 9
+
+def file_digest(path: Path, prev: dict = None) -> dict:
+    # sha1 du contenu; si taille+mtime n'ont pas bougé depuis le manifest, on réutilise le hash
+    st = path.stat()
+    if prev and prev.get("size") == st.st_size and prev.get("mtime") == st.st_mtime_ns and prev.get("sha"):
+        return {"sha": prev["sha"], "size": st.st_size, "mtime": st.st_mtime_ns}
+    h = hashlib.sha1()
+    with open(path, "rb") as f:
+        for chunk in iter(lambda: f.read(1 << 20), b""):
+            h.update(chunk)
+    return {"sha": h.hexdigest(), "size": st.st_size, "mtime": st.st_mtime_ns}
+
+def new_manifest() -> dict:
+    return {"version": MANIFEST_VERSION, "conversions": {}, "jsons": {}, "entries": {}}
+
+def load_manifest(path: Path) -> dict:
+    try:
+        data = json.loads(path.read_text(encoding="utf-8"))
+        if data.get("version") == MANIFEST_VERSION:
+            data.setdefault("conversions", {})
+            data.setdefault("jsons", {})
+            data.setdefault("entries", {})
+            return data
+    except (OSError, ValueError):
+        pass
+    return new_manifest()
+
+def save_manifest(path: Path, manifest: dict):
+    path.write_text(json.dumps(manifest, indent=1, sort_keys=True), encoding="utf-8")
+
+def conversion_options_key(fmt: str, premul: bool, mipmaps: bool, encoder: str = "texconv") -> str:
+    if fmt == "auto":
+        fmt = f"auto({AUTO_ALPHA_FORMAT},{AUTO_QUALITY_DB})"
+    if PALETTE_PAGES:
+        fmt = f"pal({PALETTE_QUALITY_DB})+{fmt}"
+    return f"{fmt}|premul={int(premul)}|mips={int(mipmaps)}|enc={encoder}"
+
+def page_format_label(fmt: str) -> str:
+    # nom court enregistré dans le JSON ("pageFormats"), lu par le loader runtime
+    if fmt == "PAL8":
+        return fmt
+    return {1: "BC1", 3: "BC3", 7: "BC7"}.get(bcenc.parse_format(fmt), fmt) if bcenc.available() else \
+        {"DXT1": "BC1", "BC1_UNORM": "BC1", "DXT5": "BC3", "BC3_UNORM": "BC3", "BC7_UNORM": "BC7"}.get(fmt.upper(), fmt)
+
+def choose_page_format(png_path: Path) -> tuple:
+    # Format le moins cher qui tient le seuil de qualité: BC1 (4 bpp) si la page est opaque, ou si son
+    # alpha survit à l'alpha 1 bit de BC1 (PSNR sur couleurs prémultipliées), sinon AUTO_ALPHA_FORMAT (8 bpp)
+    if not bcenc.available():
+        return AUTO_ALPHA_FORMAT, "no libbcenc for analysis"
+    w, h, px = bcenc.load_png(png_path)
+    alpha = px[3::4]
+    if alpha.count(255) == len(alpha):
+        return "BC1_UNORM", "opaque"
+    dec = bcenc.decode(bcenc.encode(px, w, h, "BC1"), w, h, "BC1")
+    q = bcenc.psnr_premultiplied(px, dec, w, h)
+    if q >= AUTO_QUALITY_DB:
+        return "BC1_UNORM", f"BC1 alpha {q:.1f} dB"
+    return AUTO_ALPHA_FORMAT, f"BC1 alpha {q:.1f} dB < {AUTO_QUALITY_DB}"
+
+def safe_mip_levels(rects: list, padding: int) -> tuple:
+    # Un texel du niveau L couvre 2^L texels de base, et le filtrage bilinéaire en lit un de plus:
+    # le niveau L ne mélange pas deux frames voisines tant que 2^(L+1) <= gouttière, la gouttière
+    # étant l'écart mini entre deux rects + le padding transparent à l'intérieur de chaque rect.
+    # Retourne (nombre de niveaux, gouttière); 0 niveau = chaîne complète (page sans voisins).
+    sep = None
+    for i, (ax, ay, aw, ah) in enumerate(rects):
+        for bx, by, bw, bh in rects[i + 1:]:
+            dx = max(bx - (ax + aw), ax - (bx + bw))
+            dy = max(by - (ay + ah), ay - (by + bh))
+            d = max(dx, dy, 0)
+            sep = d if sep is None else min(sep, d)
+    if sep is None:
+        return 0, None
+    gutter = sep + padding
+    levels = 1
+    while (1 << (levels + 1)) <= gutter:
+        levels += 1
+    return levels, gutter
+
+def try_palette_page(png_path: Path, dds_path: Path, premul: bool) -> tuple:
+    # -> (True, raison) si la page a été écrite en PAL8, (False, raison) sinon
+    w, h, px = bcenc.load_png(png_path) if bcenc.available() else pngio.read_png(png_path)
+    palette, index, q, why = pal8.quantize(px, premul)
+    if index is None or q < PALETTE_QUALITY_DB:
+        return False, why + (f", {q:.1f} dB < {PALETTE_QUALITY_DB}" if index is not None else "")
+    pal8.write_dds(dds_path, w, h, palette, index)
+    return True, why + (", lossless" if q == float("inf") else f", {q:.1f} dB")
+
+def page_rects(data: dict) -> tuple:
+    # rects par index de page: global -> pages du JSON, perSymbol -> pages du symbole
+    global_rects, sym_rects = {}, []
+    for sym in data.get("symbols") or []:
+        own = {}
+        target = own if isinstance(sym.get("pages"), list) else global_rects
+        for f in sym.get("frames") or []:
+            if "tiles" in f:
+                # repack_atlas.py --tiles: une rect par tuile, [dx, dy, page, x, y, w, h]
+                for _, _, pg, x, y, w, h in f["tiles"]:
+                    target.setdefault(pg, set()).add((x, y, w, h))
+            elif all(k in f for k in ("page", "x", "y", "w", "h")):
+                w, h = (f["h"], f["w"]) if f.get("rot") else (f["w"], f["h"])   # repack_atlas.py --rotate
+                target.setdefault(f["page"], set()).add((f["x"], f["y"], w, h))
+        sym_rects.append(own)
+    return global_rects, sym_rects
+
+def run_texconv(png_path: Path, dds_path: Path, fmt: str, premul: bool, mipmaps: int, encoder: str = "texconv"):
+    # mipmaps: nombre de niveaux (1 = pas de mips, 0 = chaîne complète)
+    mipmaps = int(mipmaps)
+    if encoder == "native":
+        print("BCENC:", png_path, "->", dds_path.name, fmt, "premul" if premul else "",
+              f"mips={mipmaps or 'full'}" if mipmaps != 1 else "")
+        bcenc.convert_file(png_path, dds_path, fmt, premul, mipmaps)
+        return
 
-def run_texconv(png_path: Path, dds_path: Path, fmt: str, premul: bool, mipmaps: bool):
     # texconv écrit les sorties dans un dossier via -o, et garde le nom de base
     out_dir = dds_path.parent
     out_dir.mkdir(parents=True, exist_ok=True)
@@ -17,11 +154,12 @@ def run_texconv(png_path: Path, dds_path: Path, fmt: str, premul: bool, mipmaps:
     cmd = [TEXCONV_EXE,
            "-f", fmt,
            "-o", str(out_dir),
-           "-nologo"]
+           "-nologo",
+           "-y"]                 # écrase un DDS périmé
     if premul:
         cmd += ["-pmalpha"]
-    if not mipmaps:
-        cmd += ["-m", "1"]     # 1 mip level => pas de mipmaps
+    if mipmaps:
+        cmd += ["-m", str(mipmaps)]     # 1 mip level => pas de mipmaps, 0 => chaîne complète
 
     cmd += [str(png_path)]
     print("TEXCONV:", " ".join(cmd))
@@ -29,65 +167,256 @@ def run_texconv(png_path: Path, dds_path: Path, fmt: str, premul: bool, mipmaps:
 
     # texconv produit <basename>.DDS (majuscule souvent). On renomme si besoin.
     produced = out_dir / (png_path.stem + ".DDS")
-    if produced.exists():
-        produced.rename(dds_path)
+    if produced.exists() and produced != dds_path:
+        produced.replace(dds_path)
 
-def convert_json_pages_to_dds(json_path: Path, root_dir: Path, fmt: str, premul: bool, mipmaps: bool):
-    data = json.loads(json_path.read_text(encoding="utf-8"))
+def convert_json_pages_to_dds(json_path: Path, root_dir: Path, fmt: str, premul: bool, mipmaps: bool,
+                              manifest: dict = None, encoder: str = "texconv"):
+    manifest = manifest if manifest is not None else new_manifest()
+    opts = conversion_options_key(fmt, premul, mipmaps, encoder)
+    json_key = str(json_path.relative_to(root_dir)).replace("\\", "/")
+
+    # JSON déjà réécrit par nous et pas retouché depuis => ses pages sont à jour si les DDS le sont
+    json_prev = manifest["jsons"].get(json_key)
+    json_cur = file_digest(json_path, json_prev)
+    if json_prev and json_prev.get("opts") == opts and json_prev.get("sha") == json_cur["sha"] \
+            and all(dds_up_to_date(root_dir, png, manifest) for png in json_prev.get("pngs", [])):
+        return
+
+    data = swfmeta.load(json_path)   # .json (indenté ou minifié) ou .swfb binaire
+    before = json.dumps(data, sort_keys=True)
     updated = False
+    pngs = []
+
+    padding = int(data.get("padding") or 0)
+    if any("tiles" in f for sym in data.get("symbols") or [] for f in sym.get("frames") or []):
+        padding = 0    # une tuile n'a pas de bord transparent: seule l'extrusion sépare deux tuiles
+    global_rects, sym_rects = page_rects(data)
+
+    def mip_levels_for(p, rects) -> int:
+        if not mipmaps:
+            return 1
+        levels, gutter = safe_mip_levels(sorted(rects), padding) if rects else (0, None)
+        if levels != 0:
+            print(f"MIPS: {p} -> {levels} level(s) (gutter {gutter}px)")
+        return levels
 
-    def convert_path_list(path_list):
+    def convert_path_list(path_list, formats, rects_by_page):
         nonlocal updated
         new_pages = []
-        for p in path_list:
+        for pi, p in enumerate(path_list):
+            mips = mip_levels_for(p, rects_by_page.get(pi))
             # résout le fichier relatif au root
             p_abs = (root_dir / p) if (root_dir / p).exists() else None
             if p_abs and p_abs.suffix.lower() == ".png":
                 dds_abs = p_abs.with_suffix(".dds")
-                if not dds_abs.exists():
-                    run_texconv(p_abs, dds_abs, fmt, premul, mipmaps)
+                png_key = str(Path(p)).replace("\\", "/")
+                formats.append(convert_page_if_needed(p_abs, dds_abs, png_key, fmt, premul, mips, opts, manifest, encoder))
+                pngs.append(png_key)
                 new_pages.append(str(Path(p).with_suffix(".dds")).replace("\\", "/"))
                 updated = True
             else:
+                if p_abs and p_abs.suffix.lower() == ".dds" and p_abs.with_suffix(".png").exists():
+                    # JSON déjà converti: on garde quand même le DDS synchro avec son PNG
+                    png_abs = p_abs.with_suffix(".png")
+                    png_key = str(Path(p).with_suffix(".png")).replace("\\", "/")
+                    formats.append(convert_page_if_needed(png_abs, p_abs, png_key, fmt, premul, mips, opts, manifest, encoder))
+                    pngs.append(png_key)
+                else:
+                    formats.append(None)
                 new_pages.append(p)
         return new_pages
 
-    # Global pages
+    # Global pages (+ "pageFormats" aligné sur "pages": formats mélangés possibles dans un même pack)
     if isinstance(data.get("pages"), list):
-        data["pages"] = convert_path_list(data["pages"])
+        formats = []
+        data["pages"] = convert_path_list(data["pages"], formats, global_rects)
+        if any(formats):
+            data["pageFormats"] = formats
 
     # Per-symbol pages
     if isinstance(data.get("symbols"), list):
-        for sym in data["symbols"]:
+        for sym, own_rects in zip(data["symbols"], sym_rects):
             if isinstance(sym.get("pages"), list):
-                sym["pages"] = convert_path_list(sym["pages"])
-
-    if updated:
-        json_path.write_text(json.dumps(data, indent=2), encoding="utf-8")
-
-def build_pak(root_dir: Path, pak_path: Path):
-    with ZipFile(pak_path, "w", compression=ZIP_DEFLATED, compresslevel=9) as z:
-        for p in root_dir.rglob("*"):
-            if p.is_file():
-                # on peut exclure les PNG si leur DDS existe
-                if p.suffix.lower() == ".png":
-                    dds = p.with_suffix(".dds")
-                    if dds.exists():
-                        continue
-                arc = str(p.relative_to(root_dir)).replace("\\", "/")
-                z.write(p, arcname=arc)
-    print("PAK built:", pak_path)
+                formats = []
+                sym["pages"] = convert_path_list(sym["pages"], formats, own_rects)
+                if any(formats):
+                    sym["pageFormats"] = formats
+
+    if updated or json.dumps(data, sort_keys=True) != before:
+        swfmeta.save(json_path, data)   # même format que l'exporteur a écrit
+    manifest["jsons"][json_key] = dict(file_digest(json_path), opts=opts, pngs=pngs)
+
+def meta_files(root_dir: Path) -> list:
+    """Métadonnées de SWF sous root: <swf>.json ou <swf>.swfb (Exporter.as META=json|min|bin)"""
+    return sorted(p for p in root_dir.rglob("*") if p.is_file() and swfmeta.is_meta_file(p))
+
+def dds_up_to_date(root_dir: Path, png_key: str, manifest: dict) -> bool:
+    rec = manifest["conversions"].get(png_key)
+    png_abs = root_dir / png_key
+    dds_abs = png_abs.with_suffix(".dds")
+    if not rec or not png_abs.exists() or not dds_abs.exists():
+        return False
+    src = file_digest(png_abs, rec.get("src"))
+    out = file_digest(dds_abs, rec.get("out"))
+    return src["sha"] == rec["src"]["sha"] and out["sha"] == rec["out"]["sha"]
+
+def convert_page_if_needed(png_abs: Path, dds_abs: Path, png_key: str, fmt: str, premul: bool, mipmaps: int,
+                           opts: str, manifest: dict, encoder: str = "texconv") -> str:
+    # Re-convertit seulement si le PNG, les options ou le DDS produit ont changé.
+    # Retourne le format retenu pour la page (nom court, cf. page_format_label)
+    rec = manifest["conversions"].get(png_key)
+    src = file_digest(png_abs, rec.get("src") if rec else None)
+    if rec and rec.get("opts") == opts and rec.get("mips") == mipmaps and rec["src"]["sha"] == src["sha"] \
+            and dds_abs.exists() and rec.get("format"):
+        out = file_digest(dds_abs, rec.get("out"))
+        if out["sha"] == rec["out"]["sha"]:
+            manifest["conversions"][png_key] = dict(rec, src=src, out=out)
+            return rec["format"]
+    page_fmt = fmt
+    if PALETTE_PAGES:
+        ok, why = try_palette_page(png_abs, dds_abs, premul)
+        print(f"PALETTE: {png_key} -> {'PAL8' if ok else 'no'} ({why})")
+        if ok:
+            page_fmt = "PAL8"
+    if page_fmt == "auto":
+        page_fmt, why = choose_page_format(png_abs)
+        print(f"FORMAT: {png_key} -> {page_fmt} ({why})")
+    if page_fmt != "PAL8":
+        run_texconv(png_abs, dds_abs, page_fmt, premul, mipmaps, encoder)
+    label = page_format_label(page_fmt)
+    manifest["conversions"][png_key] = {"opts": opts, "mips": mipmaps, "src": src, "out": file_digest(dds_abs), "format": label}
+    return label
+
+# ---------- Zip minimal (pour recopier les entrées inchangées sans recompresser) ----------
+ZIP_EPOCH = (1980, 1, 1, 0, 0, 0)   # date fixe => pak reproductible
+
+def _dos_datetime(dt) -> tuple:
+    y, mo, d, h, mi, s = dt
+    return (h << 11) | (mi << 5) | (s // 2), ((y - 1980) << 9) | (mo << 5) | d
+
+def read_raw_entries(pak_path: Path) -> dict:
+    # arcname -> (crc, size, method, compressed bytes) depuis un pak existant
+    out = {}
+    if not pak_path.exists():
+        return out
+    try:
+        with ZipFile(pak_path) as z, open(pak_path, "rb") as f:
+            for zi in z.infolist():
+                f.seek(zi.header_offset)
+                hdr = f.read(30)
+                if len(hdr) < 30 or hdr[:4] != b"PK\x03\x04":
+                    continue
+                n, m = struct.unpack("<HH", hdr[26:30])
+                f.seek(zi.header_offset + 30 + n + m)
+                out[zi.filename] = (zi.CRC, zi.file_size, zi.compress_type, f.read(zi.compress_size))
+    except (OSError, BadZipFile):
+        return {}
+    return out
+
+def compress_entry(data: bytes) -> tuple:
+    # deflate brut (wbits=-15), comme ZipFile avec ZIP_DEFLATED
+    co = zlib.compressobj(ZIP_LEVEL, zlib.DEFLATED, -15)
+    comp = co.compress(data) + co.flush()
+    return zlib.crc32(data) & 0xFFFFFFFF, len(data), ZIP_DEFLATED, comp
+
+def compress_file(path: Path) -> tuple:
+    return compress_entry(path.read_bytes())
+
+def write_zip(pak_path: Path, entries: list):
+    # entries: [(arcname, crc, size, method, compressed bytes)] dans l'ordre d'écriture
+    t, d = _dos_datetime(ZIP_EPOCH)
+    central = bytearray()
+    tmp = pak_path.with_name(pak_path.name + ".tmp")
+    with open(tmp, "wb") as f:
+        for arc, crc, size, method, comp in entries:
+            name = arc.encode("utf-8")
+            if size >= 0xFFFFFFFF or len(comp) >= 0xFFFFFFFF or f.tell() >= 0xFFFFFFFF:
+                raise SystemExit(f"pak too large for zip32: {arc}")
+            offset = f.tell()
+            f.write(struct.pack("<IHHHHHIIIHH", 0x04034b50, 20, 0x800, method, t, d,
+                                crc, len(comp), size, len(name), 0))
+            f.write(name)
+            f.write(comp)
+            central += struct.pack("<IHHHHHHIIIHHHHHII", 0x02014b50, 20, 20, 0x800, method, t, d,
+                                   crc, len(comp), size, len(name), 0, 0, 0, 0, 0, offset)
+            central += name
+        cd_offset = f.tell()
+        f.write(central)
+        f.write(struct.pack("<IHHHHIIH", 0x06054b50, 0, 0, len(entries), len(entries),
+                            len(central), cd_offset, 0))
+    tmp.replace(pak_path)
+
+def collect_pak_files(root_dir: Path, exclude=()) -> list:
+    files = []
+    for p in sorted(root_dir.rglob("*")):
+        if p.is_file() and p not in exclude:
+            # on peut exclure les PNG si leur DDS existe
+            if p.suffix.lower() == ".png":
+                dds = p.with_suffix(".dds")
+                if dds.exists():
+                    continue
+            files.append((str(p.relative_to(root_dir)).replace("\\", "/"), p))
+    return files
+
+def build_pak(root_dir: Path, pak_path: Path, manifest: dict = None, exclude=(), jobs: int = 0):
+    manifest = manifest if manifest is not None else new_manifest()
+    old_entries = manifest["entries"]
+    old_raw = read_raw_entries(pak_path)
+    new_entries = {}
+    out = []
+    todo = []   # (index dans out, arcname, path, digest) à recompresser
+    skip = {pak_path, pak_path.with_name(pak_path.name + ".tmp")} | set(exclude)
+    for arc, p in collect_pak_files(root_dir, skip):
+        dig = file_digest(p, old_entries.get(arc))
+        prev = old_entries.get(arc)
+        raw = old_raw.get(arc)
+        if prev and raw and prev["sha"] == dig["sha"] and raw[0] == prev.get("crc") and raw[1] == dig["size"]:
+            out.append((arc,) + raw)
+            new_entries[arc] = dict(dig, crc=raw[0])
+            continue
+        todo.append((len(out), arc, p, dig))
+        out.append(None)
+
+    # zlib relâche le GIL pendant la compression: des threads suffisent pour occuper N coeurs.
+    # L'ordre d'écriture reste celui de collect_pak_files => sortie identique à chaque run.
+    jobs = jobs or os.cpu_count() or 1
+    with ThreadPoolExecutor(max_workers=max(1, min(jobs, len(todo) or 1))) as ex:
+        for (i, arc, _, dig), ent in zip(todo, ex.map(compress_file, [t[2] for t in todo])):
+            out[i] = (arc,) + ent
+            new_entries[arc] = dict(dig, crc=ent[0])
+
+    write_zip(pak_path, out)
+    manifest["entries"] = new_entries
+    print(f"PAK built: {pak_path} ({len(out)} entries, {len(out) - len(todo)} reused, {len(todo)} recompressed)")
 
 def main():
+    global AUTO_ALPHA_FORMAT, AUTO_QUALITY_DB, PALETTE_PAGES, PALETTE_QUALITY_DB
     ap = argparse.ArgumentParser(description="Convert PNG atlases -> DDS (BC7/DXT5) and pack to .pak (zip)")
     ap.add_argument("root", help="Root folder that contains JSON + PNG pages")
     ap.add_argument("--pak", default="assets.pak", help="Output pak path (zip)")
-    ap.add_argument("--format", default=DEFAULT_FORMAT, help="DDS format for texconv (e.g. BC7_UNORM, DXT5, BC3_UNORM)")
+    ap.add_argument("--format", default=DEFAULT_FORMAT,
+                    help="DDS format (auto, BC1_UNORM, DXT5, BC3_UNORM, BC7_UNORM); auto picks BC1 per page when quality allows")
+    ap.add_argument("--alpha-format", default=AUTO_ALPHA_FORMAT, help="auto: format for pages that need real alpha (BC3_UNORM or BC7_UNORM)")
+    ap.add_argument("--quality-db", type=float, default=AUTO_QUALITY_DB, help="auto: minimum premultiplied PSNR to accept BC1 on a page with alpha")
+    ap.add_argument("--palette", action="store_true",
+                    help="Store flat-colour pages as 8-bit index + 256-colour palette (PAL8) when quality allows")
+    ap.add_argument("--palette-db", type=float, default=PALETTE_QUALITY_DB,
+                    help="--palette: minimum premultiplied PSNR to accept the palette (else BC fallback)")
     ap.add_argument("--no-premul", action="store_true", help="Disable premultiplied alpha (default: on)")
-    ap.add_argument("--mipmaps", action="store_true", help="Generate mipmaps")
+    ap.add_argument("--mipmaps", action="store_true",
+                    help="Generate mipmaps (per page, only the levels whose gutters survive downsampling)")
+    ap.add_argument("--manifest", default=None, help="Incremental build manifest (default: <pak>.manifest.json)")
+    ap.add_argument("--full", action="store_true", help="Ignore the manifest and rebuild everything")
+    ap.add_argument("--encoder", default=ENCODER, choices=["auto", "native", "texconv"],
+                    help="DDS encoder: native bc-encoder (default on Linux) or texconv")
+    ap.add_argument("--jobs", type=int, default=0, help="Parallel compression workers (default: CPU count)")
     args = ap.parse_args()
 
-    if shutil.which(TEXCONV_EXE) is None and TEXCONV_EXE == "texconv":
+    AUTO_ALPHA_FORMAT, AUTO_QUALITY_DB = args.alpha_format, args.quality_db
+    PALETTE_PAGES, PALETTE_QUALITY_DB = args.palette, args.palette_db
+    encoder = resolve_encoder(args.encoder)
+    if encoder == "texconv" and shutil.which(TEXCONV_EXE) is None and TEXCONV_EXE == "texconv":
         raise SystemExit("texconv not found in PATH. Install DirectXTex (texconv) and ensure 'texconv' is available.")
 
     root = Path(args.root).resolve()
@@ -95,13 +424,17 @@ def main():
     premul = not args.no_premul
     mipmaps = args.mipmaps
 
-    # 1) Convert all PNG pages referenced by every swf-level JSON (ex: 431.json, 494.json, etc.)
-    for json_file in root.rglob("*.json"):
-        convert_json_pages_to_dds(json_file, root, fmt, premul, mipmaps)
-
-    # 2) Build pak
     pak = Path(args.pak).resolve()
-    build_pak(root, pak)
+    manifest_path = Path(args.manifest).resolve() if args.manifest else pak.with_name(pak.name + ".manifest.json")
+    manifest = new_manifest() if args.full else load_manifest(manifest_path)
+
+    # 1) Convert all PNG pages referenced by every swf-level JSON / .swfb (ex: 431.json, 494.swfb, etc.)
+    for json_file in meta_files(root):
+        convert_json_pages_to_dds(json_file, root, fmt, premul, mipmaps, manifest, encoder)
+
+    # 2) Build pak (seules les entrées modifiées sont recompressées)
+    build_pak(root, pak, manifest, exclude={manifest_path}, jobs=args.jobs)
+    save_manifest(manifest_path, manifest)
 
 if __name__ == "__main__":
     main()
@@ -0,0 +1,204 @@
+#!/usr/bin/env python3
+# Orchestrateur export -> convert -> pack pour un dossier de SWF.
+#   python export_all.py swfs/ --out sprites_uncompressed --jobs 4 --pak-dir paks
+# Les SWF sont répartis sur N process exporteur (file de jobs locale), avec timeout et retries par job.
+# Dès qu'un SWF est exporté, ses pages sont converties en DDS et son .pak construit pendant que les
+# autres exports tournent encore. Un pak par SWF: <pak-dir>/<swf>.pak (JSON + pages à la racine).
+# Pour tester sans AIR: --exporter "python3 fake_exporter.py {args}"
+import argparse, shlex, subprocess, sys, tempfile, threading, time
+from concurrent.futures import ThreadPoolExecutor, wait, FIRST_COMPLETED
+from pathlib import Path
+
+import convert_and_pack as cap
+
+# {args} = chaîne "SWF|OUT|FPS|SCALE|PAD|ATLASW|ATLASH|DEDUP|PACKMODE|TRIM|META" attendue par Exporter.as
+EXPORTER_CMD = "adl application.xml -- args {args}"
+JOB_TIMEOUT = 600.0     # secondes par job exporteur
+JOB_RETRIES = 2         # nouvelles tentatives par SWF en échec
+
+def fmt_duration(sec: float) -> str:
+    sec = int(sec)
+    return f"{sec // 3600}h{sec // 60 % 60:02d}m" if sec >= 3600 else f"{sec // 60}m{sec % 60:02d}s"
+
+def exporter_args(swf: str, out_dir: Path, a) -> str:
+    w, h = a.atlas.lower().split("x")
+    return "|".join([swf, str(out_dir), a.fps or "", str(a.scale), str(a.pad), w, h,
+                     "0" if a.no_dedup else "1", a.pack_mode, "0" if a.no_trim else "1", a.meta])
+
+def swf_json(out_dir: Path, swf: Path) -> Path:
+    """Métadonnées écrites par l'exporteur: <swf>.json (META=json|min) ou <swf>.swfb (META=bin)"""
+    base = out_dir / swf.stem / swf.stem
+    return base.with_suffix(".swfb") if base.with_suffix(".swfb").exists() else base.with_suffix(".json")
+
+class Progress:
+    """Compteurs + ETA sur le débit observé (thread-safe, une ligne par événement)"""
+    def __init__(self, total: int):
+        self.total, self.exported, self.failed, self.packed = total, 0, 0, 0
+        self.t0 = time.monotonic()
+        self.lock = threading.Lock()
+
+    def log(self, msg: str):
+        with self.lock:
+            done = self.exported + self.failed
+            elapsed = time.monotonic() - self.t0
+            eta = elapsed / done * (self.total - done) if done else 0.0
+            print(f"[{done}/{self.total} exported, {self.packed} packed, {self.failed} failed | "
+                  f"{fmt_duration(elapsed)} elapsed, ETA {fmt_duration(eta)}] {msg}", flush=True)
+
+def run_export_job(swfs: list, a) -> tuple:
+    """Un process exporteur pour 1..K SWF (mode batch "@liste" au-delà d'un). -> (ok[], failed[], durée, log)"""
+    out_dir = Path(a.out).resolve()
+    t0 = time.time()
+    list_file = None
+    # chemins absolus: l'exporteur résout les lignes de la liste par rapport à son dossier (temp)
+    if len(swfs) == 1:
+        target = str(swfs[0].resolve())
+    else:
+        list_file = tempfile.NamedTemporaryFile("w", suffix=".txt", delete=False, encoding="utf-8")
+        list_file.write("\n".join(str(s.resolve()) for s in swfs) + "\n")
+        list_file.close()
+        target = "@" + list_file.name
+    cmd = [part.replace("{args}", exporter_args(target, out_dir, a)) for part in shlex.split(a.exporter)]
+    note = ""
+    try:
+        proc = subprocess.run(cmd, capture_output=True, text=True, timeout=a.timeout)
+        if proc.returncode != 0:
+            note = f"exit {proc.returncode}: {(proc.stderr or proc.stdout).strip()[-200:]}"
+    except subprocess.TimeoutExpired:
+        note = f"timeout after {a.timeout:.0f}s"
+    except OSError as e:
+        note = f"cannot start exporter: {e}"
+    finally:
+        if list_file:
+            Path(list_file.name).unlink(missing_ok=True)
+    # un SWF est réussi si son JSON a été (ré)écrit pendant ce job
+    ok, failed = [], []
+    for s in swfs:
+        j = swf_json(out_dir, s)
+        (ok if j.exists() and j.stat().st_mtime >= t0 - 1 else failed).append(s)
+    return ok, failed, time.time() - t0, note
+
+def convert_and_pack_swf(swf: Path, a) -> str:
+    """Étape 2/3 pour un SWF exporté: pages -> DDS puis <pak-dir>/<swf>.pak (incrémental via manifest)"""
+    root = Path(a.out).resolve() / swf.stem
+    pak = Path(a.pak_dir or a.out).resolve() / (swf.stem + ".pak")
+    pak.parent.mkdir(parents=True, exist_ok=True)
+    manifest_path = pak.with_name(pak.name + ".manifest.json")
+    manifest = cap.load_manifest(manifest_path)
+    encoder = cap.resolve_encoder(a.encoder)
+    for json_file in cap.meta_files(root):
+        cap.convert_json_pages_to_dds(json_file, root, a.format, not a.no_premul, a.mipmaps, manifest, encoder)
+    cap.build_pak(root, pak, manifest, exclude={manifest_path}, jobs=a.pak_jobs)
+    cap.save_manifest(manifest_path, manifest)
+    return str(pak)
+
+def main():
+    ap = argparse.ArgumentParser(description="Parallel SWF export + pipelined DDS conversion and packing")
+    ap.add_argument("swf_dir", help="Directory containing the .swf files (searched recursively)")
+    ap.add_argument("--out", default="sprites_uncompressed", help="Exporter output root")
+    ap.add_argument("--jobs", type=int, default=4, help="Concurrent exporter processes")
+    ap.add_argument("--per-process", type=int, default=1,
+                    help="SWFs per exporter process (batch \"@list\" mode, amortizes runtime startup)")
+    ap.add_argument("--timeout", type=float, default=JOB_TIMEOUT, help="Seconds before an exporter job is killed")
+    ap.add_argument("--retries", type=int, default=JOB_RETRIES, help="Retries per failed SWF")
+    ap.add_argument("--exporter", default=EXPORTER_CMD, help="Exporter command, {args} = Exporter.as args string")
+    ap.add_argument("--no-pack", action="store_true", help="Export only")
+    # options exporteur
+    ap.add_argument("--fps", default="", help="Forced FPS (default: SWF frame rate)")
+    ap.add_argument("--scale", type=float, default=2.0)
+    ap.add_argument("--pad", type=int, default=2)
+    ap.add_argument("--atlas", default="1024x1024", help="Atlas page size WxH")
+    ap.add_argument("--pack-mode", default="global", choices=["global", "perSymbol", "stream"])
+    ap.add_argument("--no-dedup", action="store_true")
+    ap.add_argument("--no-trim", action="store_true")
+    ap.add_argument("--meta", default="json", choices=["json", "min", "bin"],
+                    help="Metadata: indented JSON, minified JSON or binary <swf>.swfb")
+    # options convert/pack (cf. convert_and_pack.py)
+    ap.add_argument("--pak-dir", default=None, help="Where <swf>.pak files go (default: --out)")
+    ap.add_argument("--format", default=cap.DEFAULT_FORMAT)
+    ap.add_argument("--alpha-format", default=cap.AUTO_ALPHA_FORMAT, help="auto: format for pages that need real alpha (BC3_UNORM or BC7_UNORM)")
+    ap.add_argument("--quality-db", type=float, default=cap.AUTO_QUALITY_DB, help="auto: minimum premultiplied PSNR to accept BC1 on a page with alpha")
+    ap.add_argument("--no-premul", action="store_true")
+    ap.add_argument("--palette", action="store_true", help="PAL8 pages when quality allows (cf. convert_and_pack.py)")
+    ap.add_argument("--palette-db", type=float, default=cap.PALETTE_QUALITY_DB,
+                    help="--palette: minimum premultiplied PSNR to accept the palette (else BC fallback)")
+    ap.add_argument("--mipmaps", action="store_true")
+    ap.add_argument("--encoder", default=cap.ENCODER, choices=["auto", "native", "texconv"])
+    ap.add_argument("--convert-jobs", type=int, default=2, help="SWFs converted/packed concurrently")
+    ap.add_argument("--pak-jobs", type=int, default=1, help="Compression workers per pak")
+    a = ap.parse_args()
+    # mêmes globals que convert_and_pack.main: les conversions des threads packers les lisent
+    cap.AUTO_ALPHA_FORMAT, cap.AUTO_QUALITY_DB = a.alpha_format, a.quality_db
+    cap.PALETTE_PAGES, cap.PALETTE_QUALITY_DB = a.palette, a.palette_db
+
+    swfs = sorted(Path(a.swf_dir).rglob("*.swf"), key=lambda p: p.stat().st_size, reverse=True)  # gros d'abord
+    if not swfs:
+        raise SystemExit(f"No .swf under {a.swf_dir}")
+    # sorties à plat (out/<swf>, <swf>.pak): deux SWF de même nom dans des sous-dossiers s'écraseraient
+    by_stem = {}
+    for s in swfs:
+        by_stem.setdefault(s.stem.lower(), []).append(s)
+    clashes = [group for group in by_stem.values() if len(group) > 1]
+    if clashes:
+        lines = "\n".join("  " + ", ".join(str(s) for s in sorted(group)) for group in clashes)
+        raise SystemExit(f"SWF names clash (same out/<name> and <name>.pak), rename them:\n{lines}")
+    Path(a.out).mkdir(parents=True, exist_ok=True)
+    progress = Progress(len(swfs))
+    attempts = {s: 0 for s in swfs}
+    failures = {}
+
+    exporters = ThreadPoolExecutor(max_workers=max(1, a.jobs))
+    packers = ThreadPoolExecutor(max_workers=max(1, a.convert_jobs))
+    pending = {}   # future -> ("export", [swf]) | ("pack", swf)
+
+    def submit_export(group: list):
+        for s in group:
+            attempts[s] += 1
+        pending[exporters.submit(run_export_job, group, a)] = ("export", group)
+
+    k = max(1, a.per_process)
+    for i in range(0, len(swfs), k):
+        submit_export(swfs[i:i + k])
+
+    while pending:
+        done, _ = wait(list(pending), return_when=FIRST_COMPLETED)
+        for fut in done:
+            kind, what = pending.pop(fut)
+            if kind == "pack":
+                try:
+                    pak = fut.result()
+                    with progress.lock:
+                        progress.packed += 1
+                    progress.log(f"{what.name}: packed -> {pak}")
+                except Exception as e:
+                    failures[what] = f"convert/pack: {e}"
+                    progress.log(f"{what.name}: convert/pack FAILED: {e}")
+                continue
+
+            ok, failed, dur, note = fut.result()
+            for s in ok:
+                with progress.lock:
+                    progress.exported += 1
+                progress.log(f"{s.name}: exported in {dur:.1f}s (attempt {attempts[s]})")
+                if not a.no_pack:
+                    pending[packers.submit(convert_and_pack_swf, s, a)] = ("pack", s)
+            for s in failed:
+                if attempts[s] <= a.retries:
+                    progress.log(f"{s.name}: export failed ({note or 'no JSON written'}), retrying")
+                    submit_export([s])      # seul, pour isoler un SWF fautif d'un lot
+                else:
+                    failures[s] = note or "no JSON written"
+                    with progress.lock:
+                        progress.failed += 1
+                    progress.log(f"{s.name}: export FAILED after {attempts[s]} attempts ({failures[s]})")
+
+    exporters.shutdown()
+    packers.shutdown()
+    print(f"Done in {fmt_duration(time.monotonic() - progress.t0)}: {progress.exported} exported, "
+          f"{progress.packed} packed, {len(failures)} failed")
+    for s, why in failures.items():
+        print(f"  FAILED {s}: {why}")
+    sys.exit(1 if failures else 0)
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+# Stand-in local de l'exporteur AIR pour tester export_all.py sans runtime Adobe:
+#   python export_all.py swfs/ --exporter "python3 fake_exporter.py --delay 0.5 --fail-rate 0.2 {args}"
+# Lit la même chaîne "SWF|OUT|FPS|SCALE|PAD|ATLASW|ATLASH|DEDUP|PACKMODE|TRIM|META" (et "@liste") et écrit
+# OUT/<swf>/<swf>.json (ou .swfb) + atlas_N.png au format de Exporter.as (mode global), contenu dérivé du nom.
+import argparse, hashlib, random, sys, time
+from pathlib import Path
+
+import pngio
+import swfmeta
+
+def fake_export(swf: Path, out_root: Path, parts: list, rng: random.Random):
+    atlas_w = int(parts[5]) if len(parts) > 5 and parts[5] else 1024
+    atlas_h = int(parts[6]) if len(parts) > 6 and parts[6] else 1024
+    pad = int(parts[4]) if len(parts) > 4 and parts[4] else 2
+    out = out_root / swf.stem
+    out.mkdir(parents=True, exist_ok=True)
+
+    page = bytearray(atlas_w * atlas_h * 4)
+    symbols, x, y, shelf = [], 0, 0, 0
+    for si in range(rng.randint(1, 4)):
+        frames = []
+        color = bytes([rng.randrange(256), rng.randrange(256), rng.randrange(256), 255])
+        for fi in range(rng.randint(1, 6)):
+            w, h = rng.randint(16, 96), rng.randint(16, 96)
+            if x + w > atlas_w:
+                x, y, shelf = 0, y + shelf + 2, 0
+            if y + h > atlas_h:
+                break
+            for r in range(pad, h - pad):
+                o = ((y + r) * atlas_w + x + pad) * 4
+                page[o:o + (w - 2 * pad) * 4] = color * (w - 2 * pad)
+            frames.append({"idx": fi + 1, "page": 0, "x": x, "y": y, "w": w, "h": h,
+                           "ox": -w // 2, "oy": -h, "duration": 1,
+                           "poly": [{"x": pad, "y": pad}, {"x": w - pad, "y": pad}, {"x": w - pad, "y": h - pad}]})
+            x, shelf = x + w + 2, max(shelf, h)
+        symbols.append({"name": f"{swf.stem}_sym{si}", "export": f"{swf.stem}_sym{si}", "type": "MovieClip",
+                        "labels": [], "pageSet": [0], "frames": frames})
+    pngio.write_png(out / "atlas_0.png", atlas_w, atlas_h, page, level=1)
+    meta = {"swf": swf.name, "fps": 24, "scale": float(parts[3] or 2) if len(parts) > 3 else 2.0,
+            "padding": pad, "atlasSize": {"w": atlas_w, "h": atlas_h}, "pages": ["atlas_0.png"], "symbols": symbols}
+    mode = parts[10] if len(parts) > 10 and parts[10] else "json"
+    meta_path = out / (swf.stem + (".swfb" if mode == "bin" else ".json"))
+    swfmeta.save(meta_path, meta, pretty=(mode == "json"))
+    meta_path.with_suffix(".json" if mode == "bin" else ".swfb").unlink(missing_ok=True)
+    print("[ok] Export complete:", out)
+
+def main():
+    ap = argparse.ArgumentParser(description="Fake SWF exporter (same args string as Exporter.as)")
+    ap.add_argument("--delay", type=float, default=0.2, help="Seconds of simulated work per SWF")
+    ap.add_argument("--fail-rate", type=float, default=0.0, help="Probability a SWF fails")
+    ap.add_argument("--hang-rate", type=float, default=0.0, help="Probability the process hangs (timeout test)")
+    ap.add_argument("args", nargs="+", help="[args] \"SWF|OUT|...\" (a leading literal 'args' is ignored)")
+    a = ap.parse_args()
+
+    parts = a.args[-1].split("|")
+    target, out_root = parts[0], Path(parts[1])
+    if target.startswith("@"):
+        lst = Path(target[1:])
+        swfs = [lst.parent / l.strip() for l in lst.read_text(encoding="utf-8").splitlines()
+                if l.strip() and not l.startswith("#")]
+    else:
+        swfs = [Path(target)]
+
+    failed = 0
+    for swf in swfs:
+        # échecs tirés à chaque tentative; le contenu exporté, lui, ne dépend que du nom du SWF
+        rng = random.Random(hashlib.sha1(swf.name.encode()).hexdigest() + str(time.time_ns()))
+        if rng.random() < a.hang_rate:
+            time.sleep(1e6)
+        time.sleep(a.delay)
+        if not swf.exists() or rng.random() < a.fail_rate:
+            print("[err] Exception: simulated failure for", swf, file=sys.stderr)
+            failed += 1
+            continue
+        fake_export(swf, out_root, parts, random.Random(swf.name))
+    sys.exit(1 if failed else 0)
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+# Pages palettisées: index 8 bits + palette 256 x RGBA, pour les pages d'aplats (art vectoriel Flash).
+# Conteneur = DDS P8 historique (DDPF_PALETTEINDEXED8, palette 256 x 4 octets juste après l'en-tête),
+# donc même extension .dds que les pages BC pour tout le reste du pipeline; "pageFormats" vaut "PAL8".
+# Pas de mips: le runtime interpole lui-même les couleurs de palette (shader), un index ne se moyenne pas.
+import math, struct
+from collections import Counter
+from pathlib import Path
+
+DDS_MAGIC = b"DDS "
+DDSD_FLAGS = 0x1 | 0x2 | 0x4 | 0x8 | 0x1000     # CAPS | HEIGHT | WIDTH | PITCH | PIXELFORMAT
+DDPF_PALETTEINDEXED8 = 0x20
+DDSCAPS_TEXTURE = 0x1000
+MAX_DISTINCT = 4096        # au-delà, la page est trop "dégradée" pour une palette (refus immédiat)
+MAX_UNCOVERED = 0.01       # part max de pixels hors des 256 couleurs les plus fréquentes
+
+def _premul(c: int) -> tuple:
+    r, g, b, a = c & 0xFF, (c >> 8) & 0xFF, (c >> 16) & 0xFF, c >> 24
+    return (r * a + 127) // 255, (g * a + 127) // 255, (b * a + 127) // 255, a
+
+def quantize(rgba, premul: bool) -> tuple:
+    """RGBA8 -> (palette bytes 256x4, index bytes, PSNR sur couleurs prémultipliées, raison) ou (None, None, psnr, raison)
+    Palette = 256 couleurs les plus fréquentes; les autres vont vers l'entrée la plus proche (prémultipliée)."""
+    mv = memoryview(bytes(rgba)).cast("I")     # pixel = r | g<<8 | b<<16 | a<<24 (little-endian)
+    # alpha nul: toutes les couleurs sont équivalentes, une seule entrée
+    hist = Counter(mv)
+    clear = [c for c in hist if c >> 24 == 0 and c != 0]
+    for c in clear:
+        hist[0] += hist.pop(c)
+    n = len(mv)
+    if len(hist) > MAX_DISTINCT:
+        return None, None, 0.0, f"{len(hist)} colours"
+    top = [c for c, _ in hist.most_common(256)]
+    uncovered = n - sum(hist[c] for c in top)
+    if uncovered > MAX_UNCOVERED * n:
+        return None, None, 0.0, f"{len(hist)} colours, {100.0 * uncovered / n:.1f}% outside palette"
+
+    lut = {c: i for i, c in enumerate(top)}
+    pm = [_premul(c) for c in top]
+    err = 0
+    for c, cnt in hist.items():
+        if c in lut:
+            continue
+        q = _premul(c)
+        best, bd = 0, None
+        for i, p in enumerate(pm):
+            d = (q[0] - p[0]) ** 2 + (q[1] - p[1]) ** 2 + (q[2] - p[2]) ** 2 + (q[3] - p[3]) ** 2
+            if bd is None or d < bd:
+                best, bd = i, d
+        lut[c] = best
+        err += bd * cnt
+    for c in clear:
+        lut[c] = lut[0]
+    psnr = math.inf if err == 0 else 10.0 * math.log10(255.0 ** 2 / (err / (n * 4.0)))
+
+    palette = bytearray(256 * 4)
+    for i, c in enumerate(top):
+        palette[i * 4:i * 4 + 4] = bytes(_premul(c)) if premul else struct.pack("<I", c)
+    index = bytes(map(lut.__getitem__, mv))
+    return bytes(palette), index, psnr, f"{len(hist)} colours"
+
+def write_dds(path: Path, w: int, h: int, palette: bytes, index: bytes):
+    pixel_format = struct.pack("<II4sIIIII", 32, DDPF_PALETTEINDEXED8, b"\0\0\0\0", 8, 0, 0, 0, 0)
+    header = struct.pack("<IIIIIII", 124, DDSD_FLAGS, h, w, w, 0, 0) + b"\0" * 44 + pixel_format \
+        + struct.pack("<IIIII", DDSCAPS_TEXTURE, 0, 0, 0, 0)
+    Path(path).write_bytes(DDS_MAGIC + header + palette + index)
+
+def read_dds(path: Path) -> tuple:
+    """-> (w, h, palette 256x4, index) d'un DDS P8 écrit par write_dds"""
+    data = Path(path).read_bytes()
+    if data[:4] != DDS_MAGIC:
+        raise ValueError(f"{path}: not a DDS")
+    h, w = struct.unpack_from("<II", data, 12)
+    if not struct.unpack_from("<I", data, 80)[0] & DDPF_PALETTEINDEXED8:
+        raise ValueError(f"{path}: not a P8 DDS")
+    return w, h, data[128:128 + 1024], data[128 + 1024:128 + 1024 + w * h]
+
+def is_pal8_dds(path: Path) -> bool:
+    with open(path, "rb") as f:
+        head = f.read(84)
+    return len(head) == 84 and head[:4] == DDS_MAGIC and bool(struct.unpack_from("<I", head, 80)[0] & DDPF_PALETTEINDEXED8)
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+# Lecture / écriture PNG minimale (stdlib seulement) pour les outils qui retouchent les pages d'atlas.
+# Lecture: 8 bits, non entrelacé, types gris / RGB / palette / gris+A / RGBA. Sortie toujours RGBA8.
+import struct, zlib
+from pathlib import Path
+
+PNG_SIG = b"\x89PNG\r\n\x1a\n"
+_CHANNELS = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}
+
+def _chunks(data: bytes):
+    pos = len(PNG_SIG)
+    while pos + 8 <= len(data):
+        n, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        yield kind, data[pos + 8:pos + 8 + n]
+        pos += 12 + n
+
+def _paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+def _unfilter(raw: bytes, w: int, h: int, bpp: int) -> bytearray:
+    stride = w * bpp
+    out = bytearray(stride * h)
+    prev = bytearray(stride)
+    pos = 0
+    for y in range(h):
+        ft = raw[pos]
+        row = bytearray(raw[pos + 1:pos + 1 + stride])
+        pos += 1 + stride
+        if ft == 1:
+            for i in range(bpp, stride):
+                row[i] = (row[i] + row[i - bpp]) & 0xFF
+        elif ft == 2:
+            row = bytearray((a + b) & 0xFF for a, b in zip(row, prev))
+        elif ft == 3:
+            for i in range(stride):
+                left = row[i - bpp] if i >= bpp else 0
+                row[i] = (row[i] + ((left + prev[i]) >> 1)) & 0xFF
+        elif ft == 4:
+            for i in range(stride):
+                left = row[i - bpp] if i >= bpp else 0
+                ul = prev[i - bpp] if i >= bpp else 0
+                row[i] = (row[i] + _paeth(left, prev[i], ul)) & 0xFF
+        elif ft != 0:
+            raise ValueError(f"PNG: bad filter {ft}")
+        out[y * stride:(y + 1) * stride] = row
+        prev = row
+    return out
+
+def read_png(path) -> tuple:
+    """-> (width, height, bytearray RGBA8)"""
+    data = Path(path).read_bytes()
+    if not data.startswith(PNG_SIG):
+        raise ValueError(f"{path}: not a PNG")
+    idat, plte, trns = [], b"", b""
+    w = h = depth = ctype = interlace = None
+    for kind, body in _chunks(data):
+        if kind == b"IHDR":
+            w, h, depth, ctype, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            plte = body
+        elif kind == b"tRNS":
+            trns = body
+        elif kind == b"IDAT":
+            idat.append(body)
+        elif kind == b"IEND":
+            break
+    if depth != 8 or interlace != 0 or ctype not in _CHANNELS:
+        raise ValueError(f"{path}: unsupported PNG (depth={depth}, type={ctype}, interlace={interlace})")
+    ch = _CHANNELS[ctype]
+    px = _unfilter(zlib.decompress(b"".join(idat)), w, h, ch)
+    if ctype == 6:
+        return w, h, px
+    out = bytearray(w * h * 4)
+    if ctype == 2:
+        for c in range(3):
+            out[c::4] = px[c::3]
+        out[3::4] = b"\xff" * (w * h)
+    elif ctype == 0:
+        for c in range(3):
+            out[c::4] = px
+        out[3::4] = b"\xff" * (w * h)
+    elif ctype == 4:
+        for c in range(3):
+            out[c::4] = px[0::2]
+        out[3::4] = px[1::2]
+    else:  # palette
+        lut = [bytes(plte[i * 3:i * 3 + 3]) + bytes([trns[i] if i < len(trns) else 255]) for i in range(len(plte) // 3)]
+        out = bytearray(b"".join(lut[i] for i in px))
+    return w, h, out
+
+def write_png(path, w: int, h: int, rgba, level: int = 6):
+    """RGBA8 -> PNG (filtre 0 sur chaque ligne)"""
+    stride = w * 4
+    raw = b"".join(b"\x00" + bytes(rgba[y * stride:(y + 1) * stride]) for y in range(h))
+    def chunk(kind, body):
+        return struct.pack(">I", len(body)) + kind + body + struct.pack(">I", zlib.crc32(kind + body) & 0xFFFFFFFF)
+    Path(path).write_bytes(PNG_SIG
+                           + chunk(b"IHDR", struct.pack(">IIBBBBB", w, h, 8, 6, 0, 0, 0))
+                           + chunk(b"IDAT", zlib.compress(raw, level))
+                           + chunk(b"IEND", b""))
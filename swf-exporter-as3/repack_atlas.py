@@ -0,0 +1,432 @@
+#!/usr/bin/env python3
+# Repacker MaxRects des atlas produits par Exporter.as (packIntoAtlases = shelf packer sans tri).
+#   python repack_atlas.py out/MySwf/MySwf.json [--rotate] [--spacing 2] [--page-size 2048x2048]
+# Relit les pages PNG, re-place chaque rect unique (frames dédupliquées = une seule rect) en
+# best-short-side-fit, puis réécrit pages + page/x/y des frames. À lancer avant convert_and_pack.py.
+# --strategy affinity regroupe les frames par symbole (un clip = une page quand il tient) et écrit
+# "pageSet" (pages globales touchées) dans chaque symbole, pour que le runtime précharge juste ce qu'il faut.
+# Avec --rotate, une rect peut être stockée tournée de 90° (sens horaire) : la frame garde w/h logiques,
+# occupe h x w dans la page et porte "rot": 1.
+# --tiles N découpe chaque frame en tuiles NxN, dédupliquées par contenu entre toutes les frames du
+# groupe (tuiles vides omises), et écrit dans chaque frame "tiles": [[dx, dy, page, x, y, w, h], ...];
+# le runtime dessine alors la frame comme un lot de quads. Chaque tuile est entourée de TILE_EXTRUDE px
+# recopiés de son propre bord (pas de fuite bilinéaire vers la tuile voisine dans la page).
+import argparse, re
+from pathlib import Path
+
+import pngio
+import swfmeta
+
+DEFAULT_SPACING = 2   # même espacement que packIntoAtlases
+TILE_EXTRUDE = 1      # --tiles: bord recopié autour de chaque tuile
+
+# ---------------- MaxRects ----------------
+class MaxRectsBin:
+    def __init__(self, w: int, h: int):
+        self.w, self.h = w, h
+        self.free = [(0, 0, w, h)]
+        self.used = 0
+
+    def find(self, w: int, h: int):
+        # best-short-side-fit: -> (score, x, y) ou None
+        best = None
+        for fx, fy, fw, fh in self.free:
+            if w <= fw and h <= fh:
+                lx, ly = fw - w, fh - h
+                score = (min(lx, ly), max(lx, ly))
+                if best is None or score < best[0]:
+                    best = (score, fx, fy)
+        return best
+
+    def place(self, x: int, y: int, w: int, h: int):
+        out = []
+        for f in self.free:
+            fx, fy, fw, fh = f
+            if x >= fx + fw or x + w <= fx or y >= fy + fh or y + h <= fy:
+                out.append(f)
+                continue
+            if x > fx:
+                out.append((fx, fy, x - fx, fh))
+            if x + w < fx + fw:
+                out.append((x + w, fy, fx + fw - (x + w), fh))
+            if y > fy:
+                out.append((fx, fy, fw, y - fy))
+            if y + h < fy + fh:
+                out.append((fx, y + h, fw, fy + fh - (y + h)))
+        # supprime les rects libres contenues dans une autre
+        out.sort(key=lambda r: r[2] * r[3], reverse=True)
+        kept = []
+        for r in out:
+            if not any(r[0] >= k[0] and r[1] >= k[1] and r[0] + r[2] <= k[0] + k[2] and r[1] + r[3] <= k[1] + k[3]
+                       for k in kept):
+                kept.append(r)
+        self.free = kept
+
+    def clone(self):
+        b = MaxRectsBin(self.w, self.h)
+        b.free, b.used = list(self.free), self.used
+        return b
+
+def _shapes(w: int, h: int, rotate: bool) -> list:
+    return [(w, h, False)] + ([(h, w, True)] if rotate and w != h else [])
+
+def _place_one(bins: list, w: int, h: int, spacing: int, rotate: bool, page_w: int, page_h: int,
+               prefer: set = frozenset()) -> tuple:
+    # BSSF sur toutes les pages (celles de `prefer` d'abord), nouvelle page si rien ne convient
+    best = None
+    for bi, b in enumerate(bins):
+        for sw, sh, rot in _shapes(w, h, rotate):
+            hit = b.find(sw + spacing, sh + spacing)
+            if hit:
+                key = (bi not in prefer, hit[0])
+                if best is None or key < best[0]:
+                    best = (key, bi, hit[1], hit[2], sw, sh, rot)
+    if best is None:
+        b = MaxRectsBin(page_w + spacing, page_h + spacing)
+        for sw, sh, rot in _shapes(w, h, rotate):
+            hit = b.find(sw + spacing, sh + spacing)
+            if hit and (best is None or hit[0] < best[0][1]):
+                best = ((False, hit[0]), len(bins), hit[1], hit[2], sw, sh, rot)
+        if best is None:
+            raise SystemExit(f"Frame {w}x{h} does not fit in a {page_w}x{page_h} page")
+        bins.append(b)
+    _, bi, x, y, sw, sh, rot = best
+    bins[bi].place(x, y, sw + spacing, sh + spacing)
+    bins[bi].used += sw * sh
+    return bi, x, y, rot
+
+def _size_order(idx: list, sizes: list) -> list:
+    return sorted(idx, key=lambda i: (-sizes[i][1], -sizes[i][0] * sizes[i][1]))
+
+def maxrects_pack(sizes: list, page_w: int, page_h: int, spacing: int, rotate: bool) -> list:
+    """sizes: [(w, h)] -> [(page, x, y, rot)] dans le même ordre. L'espacement est ajouté à droite/en bas
+    de chaque rect, la page virtuelle est agrandie d'autant pour que le bord reste utilisable."""
+    bins, out = [], [None] * len(sizes)
+    for i in _size_order(range(len(sizes)), sizes):
+        out[i] = _place_one(bins, sizes[i][0], sizes[i][1], spacing, rotate, page_w, page_h)
+    return out
+
+def _trial(b: MaxRectsBin, items: list, sizes: list, spacing: int, rotate: bool):
+    # place tout le groupe sur une copie de la page: -> (page modifiée, placements) ou None
+    b = b.clone()
+    placed = []
+    for i in items:
+        best = None
+        for sw, sh, rot in _shapes(sizes[i][0], sizes[i][1], rotate):
+            hit = b.find(sw + spacing, sh + spacing)
+            if hit and (best is None or hit[0] < best[0]):
+                best = (hit[0], hit[1], hit[2], sw, sh, rot)
+        if best is None:
+            return None
+        _, x, y, sw, sh, rot = best
+        b.place(x, y, sw + spacing, sh + spacing)
+        b.used += sw * sh
+        placed.append((i, x, y, rot))
+    return b, placed
+
+def affinity_pack(sizes: list, owners: list, page_w: int, page_h: int, spacing: int, rotate: bool) -> list:
+    """Comme maxrects_pack, mais les rects d'un même symbole (owners[i]) vont ensemble: le clip entier sur
+    la page existante la plus remplie qui l'accepte, sinon sur une page neuve; un clip plus grand qu'une
+    page est découpé en privilégiant les pages qu'il occupe déjà."""
+    groups = {}
+    for i, g in enumerate(owners):
+        groups.setdefault(g, []).append(i)
+    order = sorted(groups.values(), key=lambda it: -sum(sizes[i][0] * sizes[i][1] for i in it))
+    bins, out = [], [None] * len(sizes)
+    for items in order:
+        items = _size_order(items, sizes)
+        best = None
+        for bi, b in enumerate(bins):
+            t = _trial(b, items, sizes, spacing, rotate)
+            if t and (best is None or t[0].used > best[1].used):
+                best = (bi, t[0], t[1])
+        if best is None:
+            t = _trial(MaxRectsBin(page_w + spacing, page_h + spacing), items, sizes, spacing, rotate)
+            if t:
+                bins.append(t[0])
+                best = (len(bins) - 1, t[0], t[1])
+        if best is not None:
+            bi, b, placed = best
+            bins[bi] = b
+            for i, x, y, rot in placed:
+                out[i] = (bi, x, y, rot)
+            continue
+        # clip trop grand pour une page: découpe
+        mine = set()
+        for i in items:
+            out[i] = _place_one(bins, sizes[i][0], sizes[i][1], spacing, rotate, page_w, page_h, mine)
+            mine.add(out[i][0])
+    return out
+
+# ---------------- pixels ----------------
+def crop(px: bytearray, page_w: int, x: int, y: int, w: int, h: int) -> bytearray:
+    out = bytearray(w * h * 4)
+    for r in range(h):
+        s = ((y + r) * page_w + x) * 4
+        out[r * w * 4:(r + 1) * w * 4] = px[s:s + w * 4]
+    return out
+
+def rotate_cw(px: bytearray, w: int, h: int) -> bytearray:
+    # w x h -> h x w, stored(col c, row r) = source(x=r, y=h-1-c)
+    out = bytearray(w * h * 4)
+    for r in range(w):
+        for c in range(h):
+            s = ((h - 1 - c) * w + r) * 4
+            d = (r * h + c) * 4
+            out[d:d + 4] = px[s:s + 4]
+    return out
+
+def rotate_ccw(px: bytearray, w: int, h: int) -> bytearray:
+    # inverse de rotate_cw: stocké w x h (déjà tourné) -> h x w logique
+    out = bytearray(w * h * 4)
+    for y in range(w):
+        for x in range(h):
+            s = (x * w + (w - 1 - y)) * 4
+            d = (y * h + x) * 4
+            out[d:d + 4] = px[s:s + 4]
+    return out
+
+def blit(dst: bytearray, page_w: int, src: bytearray, x: int, y: int, w: int, h: int):
+    for r in range(h):
+        d = ((y + r) * page_w + x) * 4
+        dst[d:d + w * 4] = src[r * w * 4:(r + 1) * w * 4]
+
+def extrude(px: bytearray, w: int, h: int, e: int) -> bytearray:
+    # w x h -> (w+2e) x (h+2e), bords recopiés (clamp)
+    out = bytearray()
+    for r in range(-e, h + e):
+        row = px[min(max(r, 0), h - 1) * w * 4:][:w * 4]
+        out += row[:4] * e + row + row[-4:] * e
+    return out
+
+# ---------------- JSON ----------------
+def stored_rect(f: dict) -> tuple:
+    # rect occupée dans la page (w/h échangés si la frame est tournée)
+    return (f["x"], f["y"], f["h"], f["w"]) if f.get("rot") else (f["x"], f["y"], f["w"], f["h"])
+
+def frame_pages(f: dict) -> set:
+    # pages lues par une frame: celles de ses tuiles (--tiles), sinon sa page
+    if "tiles" in f:
+        return {t[2] for t in f["tiles"]}
+    return {f["page"]} if "page" in f else set()
+
+def page_set(frames: list) -> list:
+    return sorted(set().union(*(frame_pages(f) for f in frames)))
+
+def page_spread(frames: list) -> float:
+    # nombre moyen de pages touchées par l'animation d'un symbole
+    per_sym = {}
+    for sym, f in frames:
+        per_sym.setdefault(sym, set()).update(frame_pages(f))
+    return sum(len(p) for p in per_sym.values()) / max(1, len(per_sym))
+
+def resolve_page(ref: str, roots: list) -> Path:
+    p = Path(ref)
+    for r in roots:
+        cand = r / p
+        if cand.suffix.lower() == ".dds" and cand.with_suffix(".png").exists():
+            return cand.with_suffix(".png")
+        if cand.exists():
+            return cand
+    raise SystemExit(f"Page not found: {ref}")
+
+def page_ref(old_refs: list, i: int) -> str:
+    # garde les noms existants, prolonge le motif <prefix>_<n>.png au besoin
+    if i < len(old_refs):
+        return str(Path(old_refs[i]).with_suffix(".png")).replace("\\", "/")
+    m = re.match(r"^(.*_)\d+$", Path(old_refs[0]).stem)
+    stem = (m.group(1) if m else Path(old_refs[0]).stem + "_") + str(i)
+    return str(Path(old_refs[0]).with_name(stem + ".png")).replace("\\", "/")
+
+def load_pages(refs: list, roots: list, args) -> tuple:
+    # -> (chemins, [(w, h, rgba)], largeur, hauteur des pages de sortie)
+    paths = [resolve_page(r, roots) for r in refs]
+    pages = [pngio.read_png(p) for p in paths]
+    if args.page_size:
+        page_w, page_h = map(int, args.page_size.lower().split("x"))
+    else:
+        page_w, page_h = max(p[0] for p in pages), max(p[1] for p in pages)
+    return paths, pages, page_w, page_h
+
+def write_pages(refs: list, paths: list, out: list, page_w: int, page_h: int) -> list:
+    new_refs = [page_ref(refs, i) for i in range(len(out))]
+    base = paths[0].parent
+    for i, ref in enumerate(new_refs):
+        pngio.write_png(base / Path(ref).name, page_w, page_h, out[i])
+    # pages devenues inutiles (et leurs DDS périmés)
+    for old in paths[len(out):]:
+        for stale in (old, old.with_suffix(".dds")):
+            if stale.exists():
+                stale.unlink()
+    return new_refs
+
+def source_image(pages: list, f: dict) -> bytearray:
+    # pixels de la frame, w x h logiques (redressée si stockée tournée)
+    _, sx, sy, sw, sh = (f["page"],) + stored_rect(f)
+    pw, _, px = pages[f["page"]]
+    img = crop(px, pw, sx, sy, sw, sh)
+    return rotate_ccw(img, sw, sh) if f.get("rot") else img
+
+def repack_group(label: str, refs: list, frames: list, roots: list, args) -> list:
+    """refs: pages du groupe, frames: [(symbole, frame)] qui y pointent -> nouvelles refs (None si inchangé)"""
+    paths, pages, page_w, page_h = load_pages(refs, roots, args)
+
+    # rects uniques (dédup de l'exporter: plusieurs frames partagent la même rect)
+    # une rect partagée entre symboles appartient au premier qui l'utilise
+    uniq, owner = {}, {}
+    for sym, f in frames:
+        k = (f["page"],) + stored_rect(f) + (bool(f.get("rot")),)
+        uniq.setdefault(k, []).append(f)
+        owner.setdefault(k, sym)
+    keys = list(uniq)
+    sizes = [(uniq[k][0]["w"], uniq[k][0]["h"]) for k in keys]
+    used = sum(w * h for w, h in sizes)
+
+    if args.strategy == "affinity":
+        placed = affinity_pack(sizes, [owner[k] for k in keys], page_w, page_h, args.spacing, args.rotate)
+    else:
+        placed = maxrects_pack(sizes, page_w, page_h, args.spacing, args.rotate)
+    new_count = 1 + max((p[0] for p in placed), default=-1)
+    before = used / max(1, len(pages) * page_w * page_h) * 100.0
+    after = used / max(1, new_count * page_w * page_h) * 100.0
+    spread_before = page_spread(frames)
+    print(f"{label}: {len(keys)} rects, pages {len(pages)} -> {new_count}, occupancy {before:.1f}% -> {after:.1f}%"
+          + (f" ({sum(1 for p in placed if p[3])} rotated)" if args.rotate else ""))
+    if new_count > len(pages) and not args.force:
+        print(f"{label}: MaxRects needs more pages than the current layout, keeping it (--force to override)")
+        return None
+
+    out = [bytearray(page_w * page_h * 4) for _ in range(new_count)]
+    for k, (pi, x, y, rot) in zip(keys, placed):
+        img = source_image(pages, uniq[k][0])
+        w, h = uniq[k][0]["w"], uniq[k][0]["h"]
+        if rot:
+            img = rotate_cw(img, w, h)
+            w, h = h, w
+        blit(out[pi], page_w, img, x, y, w, h)
+        for f in uniq[k]:
+            f["page"], f["x"], f["y"] = pi, x, y
+            if rot:
+                f["rot"] = 1
+            else:
+                f.pop("rot", None)
+
+    if len({sym for sym, _ in frames}) > 1:
+        print(f"{label}: pages per symbol (avg) {spread_before:.2f} -> {page_spread(frames):.2f}")
+    return write_pages(refs, paths, out, page_w, page_h)
+
+def tile_group(label: str, refs: list, frames: list, roots: list, args) -> list:
+    """Comme repack_group, mais en tuiles dédupliquées rangées sur une grille (pas T + 2*TILE_EXTRUDE)"""
+    paths, pages, page_w, page_h = load_pages(refs, roots, args)
+    t, e = args.tiles, TILE_EXTRUDE
+    pitch = t + 2 * e
+    cols, rows = page_w // pitch, page_h // pitch
+    if cols == 0 or rows == 0:
+        raise SystemExit(f"Tile {t}px does not fit in a {page_w}x{page_h} page")
+
+    index = {}      # (w, h, pixels) -> (page, x, y): une tuile identique n'est stockée qu'une fois
+    by_rect = {}    # rect source -> tuiles (frames dédupliquées par l'exporteur = mêmes tuiles)
+    out, assign = [], []
+    total = empty = 0
+    rect_px = 0
+    for _, f in frames:
+        k = (f["page"],) + stored_rect(f) + (bool(f.get("rot")),)
+        if k not in by_rect:
+            w, h = f["w"], f["h"]
+            img = source_image(pages, f)
+            rect_px += w * h
+            tiles = []
+            for ty in range(0, h, t):
+                for tx in range(0, w, t):
+                    tw, th = min(t, w - tx), min(t, h - ty)
+                    tile = crop(img, w, tx, ty, tw, th)
+                    total += 1
+                    if not any(tile[3::4]):
+                        empty += 1
+                        continue
+                    key = (tw, th, bytes(tile))
+                    if key not in index:
+                        pi, cell = divmod(len(index), cols * rows)
+                        if pi == len(out):
+                            out.append(bytearray(page_w * page_h * 4))
+                        x, y = (cell % cols) * pitch + e, (cell // cols) * pitch + e
+                        blit(out[pi], page_w, extrude(tile, tw, th, e), x - e, y - e, tw + 2 * e, th + 2 * e)
+                        index[key] = (pi, x, y)
+                    pi, x, y = index[key]
+                    tiles.append([tx, ty, pi, x, y, tw, th])
+            tiles.sort(key=lambda tl: tl[2])    # un lot de quads par page au rendu
+            by_rect[k] = tiles
+        assign.append((f, by_rect[k]))
+
+    quads = sum(len(tiles) for _, tiles in assign)
+    stored = len(out) * page_w * page_h
+    print(f"{label}: {total} tiles of {t}px ({empty} empty), {len(index)} unique, "
+          f"pages {len(pages)} -> {len(out)} ({len(pages) * page_w * page_h * 4 >> 10} KiB -> {stored * 4 >> 10} KiB RGBA)")
+    print(f"{label}: {len(frames)} frames, quads/frame 1 -> {quads / max(1, len(frames)):.1f} "
+          f"({4 * quads} vertices), unique rect pixels {rect_px} -> tile cells {len(index) * pitch * pitch}")
+    if len(out) > len(pages) and not args.force:
+        print(f"{label}: tiling needs more pages than the current layout, keeping it (--force to override)")
+        return None
+    for f, tiles in assign:
+        f["tiles"] = [list(tl) for tl in tiles]
+        f["page"] = tiles[0][2] if tiles else 0
+        f["x"] = f["y"] = 0
+        f.pop("rot", None)
+    return write_pages(refs, paths, out, page_w, page_h)
+
+def main():
+    ap = argparse.ArgumentParser(description="Re-pack exported atlas pages with MaxRects (BSSF)")
+    ap.add_argument("json", help="Exported <swf>.json (or <swf>.swfb)")
+    ap.add_argument("--root", help="Directory page paths are relative to (default: the JSON's directory)")
+    ap.add_argument("--spacing", type=int, default=DEFAULT_SPACING, help="Pixels between rects")
+    ap.add_argument("--rotate", action="store_true", help="Allow 90° rotation (frames get \"rot\": 1)")
+    ap.add_argument("--page-size", help="WxH of output pages (default: size of the input pages)")
+    ap.add_argument("--force", action="store_true", help="Write even if the repack needs more pages")
+    ap.add_argument("--strategy", choices=["maxrects", "affinity"], default="maxrects",
+                    help="affinity: keep each symbol's frames on as few pages as possible (global pages)")
+    ap.add_argument("--tiles", type=int, default=0,
+                    help="Split frames into NxN tiles deduplicated across frames (frames get \"tiles\")")
+    args = ap.parse_args()
+    if not 0 <= args.tiles <= 255:
+        raise SystemExit("--tiles must be 1..255")
+    pack = tile_group if args.tiles else repack_group
+
+    json_path = Path(args.json).resolve()
+    roots = [Path(args.root).resolve()] if args.root else []
+    roots += [json_path.parent, json_path.parent.parent]
+    data = swfmeta.load(json_path)
+    symbols = data.get("symbols") or []
+    if any("tiles" in f for s in symbols for f in s.get("frames") or []):
+        raise SystemExit("Frames are already tiled: re-export before repacking")
+    changed = False
+
+    # pages globales: frames de tous les symboles sans pages propres
+    if data.get("pages"):
+        frames = [(si, f) for si, s in enumerate(symbols) if not isinstance(s.get("pages"), list)
+                  for f in s.get("frames") or []]
+        refs = pack("global", data["pages"], frames, roots, args)
+        if refs is not None:
+            data["pages"] = refs
+            data.pop("pageFormats", None)   # re-déterminés par convert_and_pack.py
+            for s in symbols:
+                if not isinstance(s.get("pages"), list):
+                    s["pageSet"] = page_set(s.get("frames") or [])
+            changed = True
+
+    # mode perSymbol: chaque symbole a ses pages, dans son dossier
+    for s in symbols:
+        if isinstance(s.get("pages"), list) and s["pages"]:
+            sym_roots = roots + [r / s.get("export", "") for r in roots]
+            refs = pack(s.get("name", "symbol"), s["pages"], [(0, f) for f in s.get("frames") or []],
+                        sym_roots, args)
+            if refs is not None:
+                s["pages"] = refs
+                s.pop("pageFormats", None)
+                changed = True
+
+    if changed:
+        swfmeta.save(json_path, data)
+        print("Metadata updated:", json_path)
+
+if __name__ == "__main__":
+    main()
@@ -1,7 +1,14 @@
 // Exporter.as — AIR headless exporter for SWF symbols → Atlases + single SWF JSON
 // Usage:
-//   adl application.xml -- args "SWF|OUT|FPS|SCALE|PAD|ATLASW|ATLASH|DEDUP|PACKMODE"
-//   PACKMODE: "global" (pack toutes les anims ensemble) ou "perSymbol" (par symbole)
+//   adl application.xml -- args "SWF|OUT|FPS|SCALE|PAD|ATLASW|ATLASH|DEDUP|PACKMODE|TRIM|META"
+//   PACKMODE: "global" (pack toutes les anims ensemble), "perSymbol" (par symbole) ou
+//             "stream" (comme global, mais packé au fil du rendu: mémoire bornée pour les gros SWF)
+//   TRIM: 1 (défaut) = recadre chaque frame sur ses pixels non transparents (+PAD)
+//   META: "json" (défaut, indenté), "min" (JSON minifié) ou "bin" (<swf>.swfb little-endian, cf. swfmeta.py)
+//   SWF = "@liste.txt" => mode batch: un SWF par ligne (# = commentaire, chemins relatifs à la liste),
+//         exportés l'un après l'autre dans le même process; temps par SWF dans OUT/batch_summary.txt
+//         (JSON, mais pas en .json: convert_and_pack / le viewer prendraient le fichier pour un pack);
+//         un SWF de même nom qu'un précédent (même OUT/<nom>) n'est pas exporté et y figure en erreur
 package {
 import flash.desktop.NativeApplication;
 import flash.display.*;
@@ -12,6 +19,8 @@ import flash.net.*;
 import flash.system.*;
 import flash.utils.*;
 
+import mx.utils.SHA256;
+
 public class Exporter extends Sprite {
     private static function writeBytesTo(file:File, bytes:ByteArray):void {
         const fs:FileStream = new FileStream();
@@ -20,6 +29,16 @@ public class Exporter extends Sprite {
         fs.close();
     }
 
+    // Bitmaps (frames, pages d'atlas) créées pendant l'export du SWF courant: runExport les libère toutes
+    // en sortie, exception comprise (dispose() sur une bitmap déjà libérée ne fait rien)
+    private var liveBitmaps:Array = [];
+
+    private function newBitmap(w:int, h:int):BitmapData {
+        const bmd:BitmapData = new BitmapData(w, h, true, 0);
+        liveBitmaps.push(bmd);
+        return bmd;
+    }
+
     private static function sanitize(s:String):String {
         return s.replace(/[\/\\:\*\?"<>\|]/g, "_").replace(/\./g, "_");
     }
@@ -35,37 +54,117 @@ public class Exporter extends Sprite {
         const atlasW:int = parts[5] ? int(parts[5]) : 1024;
         const atlasH:int = parts[6] ? int(parts[6]) : 1024;
         const dedup:Boolean = parts[7] ? (int(parts[7]) != 0) : true;
-        const packMode:String = parts[8] ? String(parts[8]) : "global"; // "global" | "perSymbol"
+        const packMode:String = parts[8] ? String(parts[8]) : "global"; // "global" | "perSymbol" | "stream"
+        const trim:Boolean = parts[9] ? (int(parts[9]) != 0) : true;
+        const metaMode:String = parts[10] ? String(parts[10]) : "json"; // "json" | "min" | "bin"
 
         const oldQ:String = stage ? stage.quality : StageQuality.HIGH;
         if (stage) stage.quality = StageQuality.BEST;
 
-        const swfFile:File = new File(swfPath);
-        if (!swfFile.exists) {
-            trace("[err] SWF not found:", swfPath);
-            exit(1);
-            return;
-        }
+        const batch:Boolean = swfPath.charAt(0) == "@";
+        const swfFiles:Array = batch ? readSwfList(new File(swfPath.substr(1))) : [new File(swfPath)];
+        const timings:Array = [];
+        const outOwners:Object = {};   // dossier de sortie (nom sans .swf, casse ignorée) -> SWF qui l'a pris
+        var failed:int = 0;
 
-        const loader:Loader = new Loader();
-        loader.contentLoaderInfo.addEventListener(Event.COMPLETE, function (_:Event):void {
-            try {
-                runExport(loader, swfFile, new File(outDir), forcedFPS, scale, pad, atlasW, atlasH, dedup, packMode);
-            } catch (e:Error) {
-                trace("[err] Exception:", e.name, e.message);
-                exit(1);
-            } finally {
+        // Un SWF à la fois: le Loader précédent est déchargé (unloadAndStop) avant de charger le suivant
+        function exportNext(i:int):void {
+            if (i >= swfFiles.length) {
                 if (stage) stage.quality = oldQ;
+                if (batch) writeBatchSummary(new File(outDir), timings);
+                exit(failed > 0 ? 1 : 0);
+                return;
             }
-        });
-        const ctx:LoaderContext = new LoaderContext(false, new ApplicationDomain());
-        loader.load(new URLRequest(swfFile.url), ctx);
+            const swfFile:File = swfFiles[i] as File;
+            const t0:int = getTimer();
+            function fail(msg:String):void {
+                trace("[err]", swfFile.nativePath + ":", msg);
+                failed++;
+                timings.push({swf: swfFile.nativePath, ok: false, error: msg, totalMs: getTimer() - t0});
+            }
+            if (!swfFile.exists) {
+                fail("SWF not found");
+                exportNext(i + 1);
+                return;
+            }
+            // OUT/<nom> est à plat: un 2e SWF du même nom (autre dossier de la liste) écraserait le 1er
+            const outKey:String = swfFile.name.replace(/\.[sS][wW][fF]$/, "").toLowerCase();
+            if (outOwners.hasOwnProperty(outKey)) {
+                fail("same output folder as " + outOwners[outKey] + ", skipped");
+                exportNext(i + 1);
+                return;
+            }
+            outOwners[outKey] = swfFile.nativePath;
+
+            const loader:Loader = new Loader();
+            loader.contentLoaderInfo.addEventListener(Event.COMPLETE, function (_:Event):void {
+                const t1:int = getTimer();
+                try {
+                    const meta:Object = runExport(loader, swfFile, new File(outDir), forcedFPS, scale, pad,
+                            atlasW, atlasH, dedup, packMode, trim, metaMode);
+                    timings.push({
+                        swf: swfFile.nativePath, ok: true,
+                        loadMs: t1 - t0, exportMs: getTimer() - t1, totalMs: getTimer() - t0,
+                        symbols: meta.symbols.length, pages: meta.pages.length
+                    });
+                } catch (e:Error) {
+                    fail("Exception: " + e.name + " " + e.message);
+                }
+                while (numChildren > 0) removeChildAt(0);   // symboles restés sur la scène après une exception
+                loader.unloadAndStop(true);
+                System.gc();
+                exportNext(i + 1);
+            });
+            loader.contentLoaderInfo.addEventListener(IOErrorEvent.IO_ERROR, function (e:IOErrorEvent):void {
+                fail("load failed: " + e.text);
+                exportNext(i + 1);
+            });
+            loader.load(new URLRequest(swfFile.url), new LoaderContext(false, new ApplicationDomain()));
+        }
+        exportNext(0);
+    }
+
+    // Liste batch: un chemin de SWF par ligne, lignes vides et "#..." ignorées
+    private static function readSwfList(list:File):Array {
+        const out:Array = [];
+        if (!list.exists) {
+            trace("[err] SWF list not found:", list.nativePath);
+            return out;
+        }
+        const fs:FileStream = new FileStream();
+        fs.open(list, FileMode.READ);
+        const text:String = fs.readUTFBytes(fs.bytesAvailable);
+        fs.close();
+        for each (var line:String in text.split(/\r?\n/)) {
+            line = line.replace(/^\s+|\s+$/g, "");
+            if (!line || line.charAt(0) == "#") continue;
+            out.push(list.parent.resolvePath(line));
+        }
+        return out;
+    }
+
+    private function writeBatchSummary(outRoot:File, timings:Array):void {
+        var total:int = 0, ok:int = 0;
+        for each (var t:Object in timings) {
+            total += t.totalMs;
+            if (t.ok) ok++;
+            trace("[batch]", t.ok ? "ok " : "ERR", t.totalMs + "ms",
+                    t.ok ? "(load " + t.loadMs + "ms, export " + t.exportMs + "ms, " + t.pages + " pages)" : t.error,
+                    t.swf);
+        }
+        trace("[batch]", ok + "/" + timings.length, "SWF exported in", total + "ms");
+        outRoot.createDirectory();
+        const bytes:ByteArray = new ByteArray();
+        bytes.writeUTFBytes(JSON.stringify({swfs: timings, exported: ok, failed: timings.length - ok, totalMs: total}, null, 2));
+        writeBytesTo(outRoot.resolvePath("batch_summary.txt"), bytes);
     }
 
     // ========= MAIN ==========================================================
+    // Exporte un SWF chargé -> meta écrite dans le JSON (lève une Error en cas d'échec)
     private function runExport(loader:Loader, swfFile:File, outRoot:File,
                                forcedFPS:Number, scale:Number, pad:int,
-                               atlasW:int, atlasH:int, dedup:Boolean, packMode:String):void {
+                               atlasW:int, atlasH:int, dedup:Boolean, packMode:String, trim:Boolean,
+                               metaMode:String):Object {
         const domain:ApplicationDomain = loader.contentLoaderInfo.applicationDomain;
         const stageFPS:Number =
                 !isNaN(forcedFPS) ? forcedFPS :
@@ -76,46 +175,171 @@ public class Exporter extends Sprite {
         const swfOutDir:File = outRoot.resolvePath(swfBase);
         swfOutDir.createDirectory();
 
-        if (!("getQualifiedDefinitionNames" in domain)) {
-            trace("[err] Runtime lacks getQualifiedDefinitionNames(); need AIR/FP11+");
-            exit(1);
-            return;
+        var swfMeta:Object;
+        try {
+            if (!("getQualifiedDefinitionNames" in domain)) {
+                throw new Error("Runtime lacks getQualifiedDefinitionNames(); need AIR/FP11+");
+            }
+            const names:Vector.<String> = domain["getQualifiedDefinitionNames"]();
+
+            // SWF-level meta
+            swfMeta = {
+                swf: swfFile.name,
+                fps: stageFPS,
+                scale: scale,
+                padding: pad,
+                atlasSize: {w: atlasW, h: atlasH},
+                pages: [],     // rempli en mode global
+                symbols: []    // { name, export, type, labels, pages?, frames[] }
+            };
+
+            if (packMode == "global") {
+                exportGlobal(domain, names, swfOutDir, swfMeta, stageFPS, scale, pad, atlasW, atlasH, dedup, trim);
+            } else if (packMode == "stream") {
+                exportStream(domain, names, swfOutDir, swfMeta, stageFPS, scale, pad, atlasW, atlasH, dedup, trim);
+            } else {
+                exportPerSymbol(domain, names, swfOutDir, swfMeta, stageFPS, scale, pad, atlasW, atlasH, dedup, trim);
+            }
+
+            // Écrit la meta SWF unique (JSON indenté/minifié ou binaire), et retire celle de l'autre format
+            const metaBytes:ByteArray = new ByteArray();
+            var metaFile:File, staleFile:File;
+            if (metaMode == "bin") {
+                writeSwfBinary(swfMeta, metaBytes);
+                metaFile = swfOutDir.resolvePath(swfBase + ".swfb");
+                staleFile = swfOutDir.resolvePath(swfBase + ".json");
+            } else {
+                metaBytes.writeUTFBytes(metaMode == "min" ? JSON.stringify(swfMeta) : JSON.stringify(swfMeta, null, 2));
+                metaFile = swfOutDir.resolvePath(swfBase + ".json");
+                staleFile = swfOutDir.resolvePath(swfBase + ".swfb");
+            }
+            writeBytesTo(metaFile, metaBytes);
+            if (staleFile.exists) staleFile.deleteFile();
+
+            trace("[ok] Export complete:", swfOutDir.nativePath);
+        } finally {
+            for each (var b:BitmapData in liveBitmaps) b.dispose();
+            liveBitmaps = [];
         }
-        const names:Vector.<String> = domain["getQualifiedDefinitionNames"]();
-
-        // SWF-level meta
-        const swfMeta:Object = {
-            swf: swfFile.name,
-            fps: stageFPS,
-            scale: scale,
-            padding: pad,
-            atlasSize: {w: atlasW, h: atlasH},
-            pages: [],     // rempli en mode global
-            symbols: []    // { name, export, type, labels, pages?, frames[] }
-        };
-
-        if (packMode == "global") {
-            exportGlobal(domain, names, swfOutDir, swfMeta, stageFPS, scale, pad, atlasW, atlasH, dedup);
-        } else {
-            exportPerSymbol(domain, names, swfOutDir, swfMeta, stageFPS, scale, pad, atlasW, atlasH, dedup);
+        return swfMeta;
+    }
+
+    // ========= META BINAIRE (.swfb) ==========================================
+    // Même contenu que le JSON (sans les stats dedup/trim), little-endian, chaînes dans une table
+    // indexée en u16. Format détaillé dans swfmeta.py (lecteur/écrivain Python) et lu par test-render.
+    private static const SWFB_VERSION:int = 1;
+    private static const SWFB_NO_STRING:int = 0xFFFF;
+
+    private function writeSwfBinary(swfMeta:Object, out:ByteArray):void {
+        const strings:Array = [];
+        const stringIndex:Object = {};
+        function str(v:*):int {
+            if (v == null) return SWFB_NO_STRING;
+            const k:String = String(v);
+            if (!stringIndex.hasOwnProperty(k)) {
+                if (strings.length >= SWFB_NO_STRING) throw new Error("swfb: too many strings");
+                stringIndex[k] = strings.length;
+                strings.push(k);
+            }
+            return stringIndex[k];
+        }
+        function writePages(b:ByteArray, refs:Array, formats:Array):void {
+            b.writeShort(refs ? refs.length : 0);
+            for (var i:int = 0; refs && i < refs.length; ++i) {
+                b.writeShort(str(refs[i]));
+                b.writeShort(str(formats && i < formats.length ? formats[i] : null));
+            }
         }
 
-        // Écrit le JSON SWF unique
-        const jsonBytes:ByteArray = new ByteArray();
-        jsonBytes.writeUTFBytes(JSON.stringify(swfMeta, null, 2));
-        writeBytesTo(swfOutDir.resolvePath(swfBase + ".json"), jsonBytes);
+        // corps d'abord (remplit la table de chaînes), puis en-tête + table + corps
+        const body:ByteArray = new ByteArray();
+        body.endian = Endian.LITTLE_ENDIAN;
+        body.writeShort(str(swfMeta.swf));
+        writePages(body, swfMeta.pages, swfMeta.pageFormats);
+        body.writeShort(swfMeta.symbols.length);
+        for each (var sym:Object in swfMeta.symbols) {
+            body.writeShort(str(sym.name));
+            body.writeShort(str(sym.export));
+            body.writeShort(str(sym.type));
+            var labels:Array = sym.labels || [];
+            body.writeShort(labels.length);
+            for each (var lb:Object in labels) {
+                body.writeShort(str(lb.name));
+                body.writeShort(lb.frame);
+            }
+            writePages(body, sym.pages, sym.pageFormats);
+            var pageSet:Array = sym.pageSet || [];
+            body.writeShort(pageSet.length);
+            for each (var pg:int in pageSet) body.writeShort(pg);
+
+            body.writeShort(sym.frames.length);
+            for each (var f:Object in sym.frames) {
+                // poly: [ {x,y}... ] (un polygone) ou [ [ {x,y}... ], ... ]
+                var nested:Boolean = f.poly && f.poly.length > 0 && f.poly[0] is Array;
+                var polys:Array = !f.poly || f.poly.length == 0 ? [] : (nested ? f.poly : [f.poly]);
+                body.writeShort(f.idx);
+                body.writeShort(f.page);
+                body.writeShort(f.x);
+                body.writeShort(f.y);
+                body.writeShort(f.w);
+                body.writeShort(f.h);
+                body.writeShort(Math.round(f.ox));
+                body.writeShort(Math.round(f.oy));
+                body.writeShort(f.duration);
+                body.writeByte((f.rot ? 1 : 0) | (nested ? 2 : 0));
+                body.writeByte(polys.length);
+                for each (var poly:Array in polys) {
+                    // sommets en u8 si la frame tient dans 0..255, sinon i16 (bit 15 du compte)
+                    var wide:Boolean = false;
+                    for each (var p:Object in poly) {
+                        var px:int = Math.round(p.x), py:int = Math.round(p.y);
+                        if (px < 0 || py < 0 || px > 255 || py > 255) { wide = true; break; }
+                    }
+                    body.writeShort(poly.length | (wide ? 0x8000 : 0));
+                    for each (p in poly) {
+                        if (wide) {
+                            body.writeShort(Math.round(p.x));
+                            body.writeShort(Math.round(p.y));
+                        } else {
+                            body.writeByte(Math.round(p.x));
+                            body.writeByte(Math.round(p.y));
+                        }
+                    }
+                }
+            }
+        }
 
-        trace("[ok] Export complete:", swfOutDir.nativePath);
-        exit(0);
+        out.endian = Endian.LITTLE_ENDIAN;
+        out.writeUTFBytes("SWFB");
+        out.writeShort(SWFB_VERSION);
+        out.writeShort(0);   // flags
+        out.writeFloat(swfMeta.fps);
+        out.writeFloat(swfMeta.scale);
+        out.writeShort(swfMeta.padding);
+        out.writeShort(swfMeta.atlasSize.w);
+        out.writeShort(swfMeta.atlasSize.h);
+        out.writeShort(strings.length);
+        const utf:ByteArray = new ByteArray();
+        for each (var s:String in strings) {
+            utf.clear();
+            utf.writeUTFBytes(s);
+            out.writeShort(utf.length);
+            out.writeBytes(utf);
+        }
+        out.writeBytes(body);
     }
 
     // ========= GLOBAL PACK: toutes les frames ensemble ======================
     private function exportGlobal(domain:ApplicationDomain, names:Vector.<String>, swfOutDir:File, swfMeta:Object,
-                                  fps:Number, scale:Number, pad:int, atlasW:int, atlasH:int, dedup:Boolean):void {
+                                  fps:Number, scale:Number, pad:int, atlasW:int, atlasH:int, dedup:Boolean,
+                                  trim:Boolean):void {
         // 1) Rendre toutes les frames de tous les symboles -> frames[]
         var frames:Array = []; // items: { bmp,w,h,ox,oy, idx, duration, symIndex:int, symName:String }
         var symbols:Array = []; // sortie: mapping des frames par symbole
         var symIndex:int = 0;
+        var pixelIndex:Object = {};   // hash pixels -> frames déjà rendues (dédup entre symboles)
+        var dedupStats:Object = {sharedFrames: 0, savedPixels: 0};
+        var trimStats:Object = {renderedPixels: 0, reclaimedPixels: 0};
 
         for each (var qname:String in names) {
             var cls:Class;
@@ -161,7 +385,7 @@ public class Exporter extends Sprite {
                 var ox:Number = raw.x * scale - pad;
                 var oy:Number = raw.y * scale - pad;
 
-                var bmd:BitmapData = new BitmapData(outW, outH, true, 0);
+                var bmd:BitmapData = newBitmap(outW, outH);
                 var mtx:Matrix = new Matrix();
                 mtx.scale(scale, scale);
                 mtx.translate(-raw.x * scale + pad, -raw.y * scale + pad);
@@ -178,6 +402,10 @@ public class Exporter extends Sprite {
                     symIndex: symIndex,
                     symName: qname
                 };
+                if (trim) {
+                    trimTransparent(cur, pad, trimStats);
+                    bmd = cur.bmp as BitmapData;
+                }
                 cur.poly = computeConvexHullPolygon(
                         bmd,
                         /*alphaThresh*/ 96,   // plus haut = moins permissif
@@ -186,10 +414,11 @@ public class Exporter extends Sprite {
                 );
 
 
-                if (dedup && last && samePixels(last.bmp as BitmapData, bmd)) {
+                if (dedup && last && samePixels(frameBitmap(last), bmd)) {
                     last.duration += 1;
                     bmd.dispose();
                 } else {
+                    if (dedup) shareIdenticalFrame(pixelIndex, cur, dedupStats);
                     rendered.push(cur);
                     last = cur;
                 }
@@ -216,6 +445,8 @@ public class Exporter extends Sprite {
 
         // 2) Packer toutes les frames ensemble
         var packRes:Object = packIntoAtlases(frames, atlasW, atlasH, /*spacing*/2);
+        reportDedup(swfMeta, dedupStats, packedArea(frames));
+        if (trim) reportTrim(swfMeta, trimStats);
 
         // 3) Sauver les pages globales
         var pageFiles:Array = [];
@@ -235,8 +466,10 @@ public class Exporter extends Sprite {
         for (var si:int = 0; si < symbols.length; ++si) {
             var sym:Object = symbols[si];
             var framesMeta:Array = [];
+            var pageSet:Array = [];   // pages globales touchées par le symbole (préchargement runtime)
             for each (var fi:int in sym.frameIndices) {
                 var it:Object = packRes.items[fi]; // {page,x,y,w,h,ox,oy,idx,duration,symIndex}
+                if (pageSet.indexOf(it.page) < 0) pageSet.push(it.page);
                 framesMeta.push({
                     idx: it.idx,
                     page: it.page,
@@ -252,6 +485,7 @@ public class Exporter extends Sprite {
                 export: sym.export,
                 type: sym.type,
                 labels: sym.labels,
+                pageSet: pageSet.sort(Array.NUMERIC),
                 frames: framesMeta
             });
         }
@@ -262,7 +496,11 @@ public class Exporter extends Sprite {
 
     // ========= PER SYMBOL PACK (comme avant, mais atlas + JSON par symbole) ==
     private function exportPerSymbol(domain:ApplicationDomain, names:Vector.<String>, swfOutDir:File, swfMeta:Object,
-                                     fps:Number, scale:Number, pad:int, atlasW:int, atlasH:int, dedup:Boolean):void {
+                                     fps:Number, scale:Number, pad:int, atlasW:int, atlasH:int, dedup:Boolean,
+                                     trim:Boolean):void {
+        var dedupStats:Object = {sharedFrames: 0, savedPixels: 0};
+        var trimStats:Object = {renderedPixels: 0, reclaimedPixels: 0};
+        var packedFrames:Array = [];
         for each (var qname:String in names) {
             var cls:Class;
             try {
@@ -290,6 +528,7 @@ public class Exporter extends Sprite {
 
             var rendered:Array = [];
             var last:Object = null;
+            var pixelIndex:Object = {};   // pages propres au symbole: dédup limitée au symbole
             for (var f:int = 1; f <= total; f++) {
                 if (mc) mc.gotoAndStop(f);
                 var raw:Rectangle = disp.getBounds(this);
@@ -299,20 +538,25 @@ public class Exporter extends Sprite {
                 var ox:Number = raw.x * scale - pad;
                 var oy:Number = raw.y * scale - pad;
 
-                var bmd:BitmapData = new BitmapData(outW, outH, true, 0);
+                var bmd:BitmapData = newBitmap(outW, outH);
                 var mtx:Matrix = new Matrix();
                 mtx.scale(scale, scale);
                 mtx.translate(-raw.x * scale + pad, -raw.y * scale + pad);
                 bmd.draw(disp, mtx, null, null, null, true);
 
                 var cur:Object = {bmp: bmd, w: outW, h: outH, ox: ox, oy: oy, idx: f, duration: 1};
+                if (trim) {
+                    trimTransparent(cur, pad, trimStats);
+                    bmd = cur.bmp as BitmapData;
+                }
                 cur.poly = computeConvexHullPolygon(bmd, 96, -1, 1.0);
 
 
-                if (dedup && last && samePixels(last.bmp as BitmapData, bmd)) {
+                if (dedup && last && samePixels(frameBitmap(last), bmd)) {
                     last.duration += 1;
                     bmd.dispose();
                 } else {
+                    if (dedup) shareIdenticalFrame(pixelIndex, cur, dedupStats);
                     rendered.push(cur);
                     last = cur;
                 }
@@ -357,9 +601,190 @@ public class Exporter extends Sprite {
                 frames: framesMeta
             });
 
-            for each (var fr:Object in rendered) if (fr.bmp) BitmapData(fr.bmp).dispose();
+            for each (var fr:Object in rendered) {
+                if (fr.bmp) BitmapData(fr.bmp).dispose();
+                packedFrames.push(fr);
+            }
+            removeChild(disp);
+        }
+        reportDedup(swfMeta, dedupStats, packedArea(packedFrames));
+        if (trim) reportTrim(swfMeta, trimStats);
+    }
+
+    // ========= STREAM PACK: global, packé au fil du rendu ===================
+    // Chaque frame est packée dès son rendu puis libérée, et une page est encodée/écrite dès qu'elle
+    // est pleine: le pic mémoire reste ~ page ouverte + frame courante + frame précédente (dédup
+    // consécutive), quelle que soit la taille du SWF. Même shelf packer et même JSON que "global".
+    private function exportStream(domain:ApplicationDomain, names:Vector.<String>, swfOutDir:File, swfMeta:Object,
+                                  fps:Number, scale:Number, pad:int, atlasW:int, atlasH:int, dedup:Boolean,
+                                  trim:Boolean):void {
+        var packer:Object = {page: null, index: -1, x: 0, y: 0, shelfH: 0, spacing: 2,
+            w: atlasW, h: atlasH, dir: swfOutDir, files: []};
+        var pixelIndex:Object = {};   // hash pixels -> rect déjà packée (sans garder la bitmap)
+        var dedupStats:Object = {sharedFrames: 0, savedPixels: 0};
+        var trimStats:Object = {renderedPixels: 0, reclaimedPixels: 0};
+        var packed:Number = 0;
+
+        for each (var qname:String in names) {
+            var cls:Class;
+            try {
+                cls = domain.hasDefinition(qname) ? domain.getDefinition(qname) as Class : null;
+            } catch (_:*) {
+                cls = null;
+            }
+            if (!cls) continue;
+
+            if (qname.indexOf("DisplayInfo_") != -1) {
+                continue;
+            }
+
+            var inst:Object;
+            try {
+                inst = new cls();
+            } catch (_:*) {
+                continue;
+            }
+            if (!(inst is DisplayObject)) continue;
+
+            var mc:MovieClip = inst as MovieClip;
+            var disp:DisplayObject = inst as DisplayObject;
+            addChild(disp);
+
+            var total:int = mc ? mc.totalFrames : 1;
+            var labels:Array = [];
+            if (mc) for each (var fl:FrameLabel in mc.currentLabels) labels.push({name: fl.name, frame: fl.frame});
+
+            var framesMeta:Array = [];
+            var pageSet:Array = [];
+            var last:Object = null;          // meta de la frame précédente
+            var lastBmp:BitmapData = null;   // et ses pixels (dédup consécutive)
+
+            for (var f:int = 1; f <= total; f++) {
+                if (mc) mc.gotoAndStop(f);
+                var cur:Object = renderFrame(disp, f, scale, pad);
+                if (trim) trimTransparent(cur, pad, trimStats);
+                var bmd:BitmapData = cur.bmp as BitmapData;
+
+                if (dedup && last && samePixels(lastBmp, bmd)) {
+                    last.duration += 1;
+                    bmd.dispose();
+                    continue;
+                }
+                cur.poly = computeConvexHullPolygon(bmd, 96, -1, 1.0);
+
+                var key:String = dedup ? pixelHash(bmd) : null;
+                var rect:Object = key ? pixelIndex[key] : null;
+                if (rect && !sameAsPacked(packer, rect, bmd)) rect = null;
+                if (rect) {
+                    dedupStats.sharedFrames++;
+                    dedupStats.savedPixels += cur.w * cur.h;
+                } else {
+                    rect = streamPack(packer, bmd);
+                    packed += cur.w * cur.h;
+                    if (key && !pixelIndex[key]) {
+                        rect.digest = pixelDigest(bmd);
+                        pixelIndex[key] = rect;
+                    }
+                }
+
+                var meta:Object = {
+                    idx: f,
+                    page: rect.page,
+                    x: rect.x, y: rect.y, w: cur.w, h: cur.h,
+                    ox: cur.ox, oy: cur.oy,
+                    duration: 1,
+                    poly: cur.poly
+                };
+                framesMeta.push(meta);
+                if (pageSet.indexOf(rect.page) < 0) pageSet.push(rect.page);
+                if (lastBmp) lastBmp.dispose();
+                lastBmp = bmd;
+                last = meta;
+            }
+            if (lastBmp) lastBmp.dispose();
+
+            swfMeta.symbols.push({
+                name: qname,
+                export: sanitize(qname),
+                type: (mc ? "MovieClip" : "DisplayObject"),
+                labels: labels,
+                pageSet: pageSet.sort(Array.NUMERIC),
+                frames: framesMeta
+            });
             removeChild(disp);
         }
+
+        flushStreamPage(packer);
+        swfMeta.pages = packer.files;
+        reportDedup(swfMeta, dedupStats, packed);
+        if (trim) reportTrim(swfMeta, trimStats);
+    }
+
+    // Rend la frame courante de disp: bounds vectoriels * scale + pad de chaque côté
+    private function renderFrame(disp:DisplayObject, f:int, scale:Number, pad:int):Object {
+        var raw:Rectangle = disp.getBounds(this);
+        if (raw.width < 1 || raw.height < 1) raw = new Rectangle(0, 0, Math.max(1, disp.width), Math.max(1, disp.height));
+        var outW:int = int(Math.ceil(raw.width * scale)) + pad * 2;
+        var outH:int = int(Math.ceil(raw.height * scale)) + pad * 2;
+
+        var bmd:BitmapData = newBitmap(outW, outH);
+        var mtx:Matrix = new Matrix();
+        mtx.scale(scale, scale);
+        mtx.translate(-raw.x * scale + pad, -raw.y * scale + pad);
+        bmd.draw(disp, mtx, null, null, null, true);
+        return {bmp: bmd, w: outW, h: outH, ox: raw.x * scale - pad, oy: raw.y * scale - pad, idx: f, duration: 1};
+    }
+
+    // Shelf packer en ligne (même placement que packIntoAtlases): copie bmd dans la page ouverte,
+    // écrit la page pleine avant d'en ouvrir une autre. -> {page,x,y}
+    private function streamPack(p:Object, bmd:BitmapData):Object {
+        var w:int = bmd.width, h:int = bmd.height;
+        if (!p.page) newStreamPage(p);
+        if (p.x + w > p.w) {
+            p.x = 0;
+            p.y += p.shelfH + p.spacing;
+            p.shelfH = 0;
+        }
+        if (p.y + h > p.h) {
+            flushStreamPage(p);
+            newStreamPage(p);
+        }
+        BitmapData(p.page).copyPixels(bmd, bmd.rect, new Point(p.x, p.y), null, null, true);
+        var rect:Object = {page: p.index, x: p.x, y: p.y};
+        p.x += w + p.spacing;
+        p.shelfH = Math.max(p.shelfH, h);
+        return rect;
+    }
+
+    private function newStreamPage(p:Object):void {
+        p.page = newBitmap(p.w, p.h);
+        p.index++;
+        p.x = 0;
+        p.y = 0;
+        p.shelfH = 0;
+    }
+
+    private function flushStreamPage(p:Object):void {
+        if (!p.page) return;
+        var bytes:ByteArray = new ByteArray();
+        BitmapData(p.page).encode(BitmapData(p.page).rect, new PNGEncoderOptions(true), bytes);
+        var pageName:String = "atlas_" + p.index + ".png";
+        writeBytesTo(File(p.dir).resolvePath(pageName), bytes);
+        BitmapData(p.page).dispose();
+        p.page = null;
+        p.files.push(pageName);
+        trace("[stream] page written:", pageName);
+    }
+
+    // Vérifie un hit de hash contre la rect packée: compare() si sa page est encore ouverte, sinon
+    // SHA-256 des pixels gardé avec la rect (la page écrite ne peut plus être relue)
+    private function sameAsPacked(p:Object, rect:Object, bmd:BitmapData):Boolean {
+        if (rect.page != p.index || !p.page) return rect.digest == pixelDigest(bmd);
+        var tmp:BitmapData = new BitmapData(bmd.width, bmd.height, true, 0);
+        tmp.copyPixels(BitmapData(p.page), new Rectangle(rect.x, rect.y, bmd.width, bmd.height), new Point(0, 0));
+        var same:Boolean = samePixels(tmp, bmd);
+        tmp.dispose();
+        return same;
     }
 
     // ========= PACKER / UTILS ===============================================
@@ -370,16 +795,110 @@ public class Exporter extends Sprite {
         return (cmp is uint) && (uint(cmp) == 0);
     }
 
+    // Recadre la frame sur ses pixels non transparents + pad: les bounds vectoriels (getBounds) gardent
+    // souvent des marges vides (filtres, traits invisibles, contenu masqué). ox/oy suivent le recadrage.
+    private function trimTransparent(cur:Object, pad:int, stats:Object):void {
+        var bmd:BitmapData = cur.bmp as BitmapData;
+        var area:int = bmd.width * bmd.height;
+        stats.renderedPixels += area;
+        var cb:Rectangle = bmd.getColorBoundsRect(0xFF000000, 0, false);
+        if (cb.width < 1 || cb.height < 1) cb = new Rectangle(0, 0, 1, 1); // frame vide: 1px
+        var w:int = int(cb.width) + pad * 2, h:int = int(cb.height) + pad * 2;
+        if (w * h >= area) return;
+
+        var out:BitmapData = newBitmap(w, h);
+        out.copyPixels(bmd, cb, new Point(pad, pad));
+        bmd.dispose();
+        stats.reclaimedPixels += area - w * h;
+        cur.bmp = out;
+        cur.w = w;
+        cur.h = h;
+        cur.ox += cb.x - pad;
+        cur.oy += cb.y - pad;
+    }
+
+    private function reportTrim(swfMeta:Object, stats:Object):void {
+        var pct:Number = stats.renderedPixels > 0 ? 100 * stats.reclaimedPixels / stats.renderedPixels : 0;
+        swfMeta.trim = {renderedPixels: stats.renderedPixels, reclaimedPixels: stats.reclaimedPixels};
+        trace("[trim]", stats.reclaimedPixels, "of", stats.renderedPixels, "px reclaimed (" + pct.toFixed(1) + "%)");
+    }
+
+    // Bitmap réelle d'une frame (une frame partagée n'a pas la sienne)
+    private static function frameBitmap(fr:Object):BitmapData {
+        return (fr.shareOf ? fr.shareOf.bmp : fr.bmp) as BitmapData;
+    }
+
+    // Hash des pixels (dimensions + 2 hash 32 bits sur getVector). Les collisions sont tranchées par
+    // compare() tant que l'original est en mémoire; en mode stream, une page déjà écrite ne peut plus
+    // être relue et c'est pixelDigest (gardé avec la rect) qui tranche.
+    private static function pixelHash(bmd:BitmapData):String {
+        var v:Vector.<uint> = bmd.getVector(bmd.rect);
+        var h:uint = 2166136261, g:uint = 5381;
+        for (var i:int = 0, n:int = v.length; i < n; ++i) {
+            h ^= v[i];
+            h += (h << 1) + (h << 4) + (h << 7) + (h << 8) + (h << 24);   // FNV-1a, modulo 2^32
+            g = ((g << 5) - g + v[i]) >>> 0;                               // g*31 + px
+        }
+        return bmd.width + "x" + bmd.height + ":" + hex8(h) + hex8(g);
+    }
+
+    // Empreinte forte des pixels (SHA-256 de getPixels): 64 octets par rect au lieu de la bitmap
+    private static function pixelDigest(bmd:BitmapData):String {
+        return SHA256.computeDigest(bmd.getPixels(bmd.rect));
+    }
+
+    // 8 chiffres hexa: les deux moitiés de la clé ne peuvent pas glisser l'une dans l'autre ("1"+"23" / "12"+"3")
+    private static function hex8(v:uint):String {
+        return ("0000000" + v.toString(16)).substr(-8);
+    }
+
+    // Dédup par contenu, au-delà de la frame précédente: si une frame identique a déjà été rendue
+    // (ailleurs dans le symbole ou dans un autre symbole), cur la référence (shareOf) et rend sa bitmap;
+    // le packer lui donnera la même rect. ox/oy/poly restent propres à la frame.
+    private function shareIdenticalFrame(index:Object, cur:Object, stats:Object):void {
+        var bmd:BitmapData = cur.bmp as BitmapData;
+        var key:String = pixelHash(bmd);
+        var bucket:Array = index[key] as Array;
+        if (bucket) {
+            for each (var other:Object in bucket) {
+                if (samePixels(other.bmp as BitmapData, bmd)) {
+                    cur.shareOf = other;
+                    cur.bmp = null;
+                    bmd.dispose();
+                    stats.sharedFrames++;
+                    stats.savedPixels += cur.w * cur.h;
+                    return;
+                }
+            }
+        } else {
+            bucket = index[key] = [];
+        }
+        bucket.push(cur);
+    }
+
+    private static function packedArea(frames:Array):Number {
+        var packed:Number = 0;
+        for each (var fr:Object in frames) if (!fr.shareOf) packed += fr.w * fr.h;
+        return packed;
+    }
+
+    private function reportDedup(swfMeta:Object, stats:Object, packed:Number):void {
+        var pct:Number = (packed + stats.savedPixels) > 0 ? 100 * stats.savedPixels / (packed + stats.savedPixels) : 0;
+        swfMeta.dedup = {sharedFrames: stats.sharedFrames, savedPixels: stats.savedPixels, packedPixels: packed};
+        trace("[dedup]", stats.sharedFrames, "frames share an existing rect,", stats.savedPixels,
+                "px saved (" + pct.toFixed(1) + "% of atlas area)");
+    }
+
     // Shelf packer: retourne { pages:[BitmapData], items:[{..}] } dans le même ordre que frames[]
     private function packIntoAtlases(frames:Array, pageW:int, pageH:int, spacing:int):Object {
         var pages:Array = [];
         var items:Array = [];
-        var page:BitmapData = new BitmapData(pageW, pageH, true, 0);
+        var page:BitmapData = newBitmap(pageW, pageH);
         pages.push(page);
         var x:int = 0, y:int = 0, shelfH:int = 0, pageIndex:int = 0;
 
         function newPage():void {
-            page = new BitmapData(pageW, pageH, true, 0);
+            page = newBitmap(pageW, pageH);
             pages.push(page);
             x = 0;
             y = 0;
@@ -388,6 +907,10 @@ public class Exporter extends Sprite {
         }
 
         for each (var f:Object in frames) {
+            if (f.shareOf) {
+                items.push(null);   // résolu après le pack: même rect que la frame partagée
+                continue;
+            }
             var w:int = f.w, h:int = f.h;
             if (x + w > pageW) {
                 x = 0;
@@ -411,9 +934,19 @@ public class Exporter extends Sprite {
                 symIndex: f.symIndex,
                 poly: f.poly
             });
+            f.item = items[items.length - 1];
             x += w + spacing;
             shelfH = Math.max(shelfH, h);
         }
+        for (var i:int = 0; i < frames.length; ++i) {
+            var sf:Object = frames[i];
+            if (!sf.shareOf) continue;
+            var src:Object = sf.shareOf.item;
+            items[i] = {
+                idx: sf.idx, page: src.page, x: src.x, y: src.y, w: src.w, h: src.h,
+                ox: sf.ox, oy: sf.oy, duration: sf.duration, symIndex: sf.symIndex, poly: sf.poly
+            };
+        }
         return {pages: pages, items: items};
     }
 
@@ -423,115 +956,69 @@ public class Exporter extends Sprite {
         });
     }
 
-// ---------- CONVEX HULL (Graham scan) ---------------------------------------
+// ---------- CONVEX HULL (monotone chain) ------------------------------------
 
-// Renvoie un polygone convexe en coords pixels locales au bitmap recadré (0..w,0..h)
+// Renvoie un polygone convexe en coords pixels locales au bitmap recadré (0..w,0..h).
+// Un seul getVector; sur chaque ligne échantillonnée seuls le premier et le dernier pixel opaques
+// peuvent être sur l'enveloppe, puis chaîne monotone d'Andrew sur coordonnées entières.
     private function computeConvexHullPolygon(
             bmd:BitmapData,
             alphaThresh:int = 96,   // seuil alpha (plus haut => moins permissif)
-            sampleStep:int = -1,    // -1 = step adaptatif en fct de la taille
+            sampleStep:int = -1,    // -1 = step adaptatif en fct de la taille (lignes)
             shrinkPx:Number = 1.0   // 0 pour désactiver, sinon "inset" anti-AA
     ):Array {
         var W:int = bmd.width, H:int = bmd.height;
         if (W <= 0 || H <= 0) return [];
 
         var step:int = (sampleStep > 0) ? sampleStep
-                : Math.max(1, Math.floor(Math.min(W, H) / 50)); // ~200 pts max
-
-        var pts:Array = sampleOpaquePoints(bmd, alphaThresh, step);
-        if (pts.length < 3) return [];
-
-        var hull:Array = grahamScan(pts);
-
-        if (shrinkPx > 0 && hull.length >= 3) {
-            hull = shrinkPolygonTowardCentroid(hull, shrinkPx);
-        }
-        return hull;
-    }
-
-// Echantillonne les pixels opaques (stride = step) -> Array de {x,y}
-    private function sampleOpaquePoints(bmd:BitmapData, alphaThresh:int, step:int):Array {
-        var W:int = bmd.width, H:int = bmd.height, pts:Array = [];
-        var a:int;
-        for (var y:int = 0; y < H; y += step) {
-            for (var x:int = 0; x < W; x += step) {
-                a = (bmd.getPixel32(x, y) >>> 24) & 0xFF;
-                if (a >= alphaThresh) pts.push({x: x, y: y});
-            }
-        }
-        // Toujours assurer qu'on a des points en bord si jamais l'objet touche le bord
-        // (utile quand le pad=0) :
-        // lignes du bas/droite (sans dupliquer)
-        for (x = 0; x < W; x += step) {
-            y = H - 1;
-            a = (bmd.getPixel32(x, y) >>> 24) & 0xFF;
-            if (a >= alphaThresh) pts.push({x: x, y: y});
-        }
-        for (y = 0; y < H; y += step) {
-            x = W - 1;
-            a = (bmd.getPixel32(x, y) >>> 24) & 0xFF;
-            if (a >= alphaThresh) pts.push({x: x, y: y});
-        }
-        // dédoublonnage grossier
-        var seen:Object = {};
-        var uniq:Array = [];
-        for each (var p:Object in pts) {
-            var k:String = (p.x << 16) + ":" + p.y;
-            if (!seen[k]) {
-                seen[k] = true;
-                uniq.push(p);
+                : Math.max(1, Math.floor(Math.min(W, H) / 50));
+
+        // extrêmes gauche/droite par ligne, clés x<<16|y (tri numérique = tri par x puis y)
+        var px:Vector.<uint> = bmd.getVector(bmd.rect);
+        var thresh:uint = uint(alphaThresh) << 24;
+        var keys:Array = [];
+        for (var y:int = 0; y < H; y = (y + step < H || y == H - 1) ? y + step : H - 1) {
+            var row:int = y * W;
+            var l:int = 0;
+            while (l < W && px[row + l] < thresh) ++l;
+            if (l < W) {
+                var r:int = W - 1;
+                while (px[row + r] < thresh) --r;
+                keys.push((l << 16) | y);
+                if (r != l) keys.push((r << 16) | y);
             }
         }
-        return uniq;
-    }
-
-// Graham scan sur Array<{x,y}> -> convex hull (Array<{x,y}>)
-    private function grahamScan(points:Array):Array {
-        if (points.length < 3) return points.concat();
-
-        // 1) Point de départ = plus bas (y), puis le plus à gauche (x)
-        var start:Object = points[0];
-        for each (var p:Object in points) {
-            if (p.y < start.y || (p.y == start.y && p.x < start.x)) start = p;
-        }
-
-        // 2) Trie par angle polaire autour de "start", puis par distance
-        var rest:Array = [];
-        for each (p in points) if (p !== start) rest.push(p);
-
-        rest.sort(function (a:Object, b:Object):Number {
-            var angA:Number = Math.atan2(a.y - start.y, a.x - start.x);
-            var angB:Number = Math.atan2(b.y - start.y, b.x - start.x);
-            if (angA < angB) return -1;
-            if (angA > angB) return 1;
-            // même angle -> plus proche en premier
-            var dA:Number = (a.x - start.x) * (a.x - start.x) + (a.y - start.y) * (a.y - start.y);
-            var dB:Number = (b.x - start.x) * (b.x - start.x) + (b.y - start.y) * (b.y - start.y);
-            if (dA < dB) return -1;
-            if (dA > dB) return 1;
-            return 0;
-        });
+        if (keys.length < 3) return [];
+        keys.sort(Array.NUMERIC);
 
-        // 3) Construction
-        var hull:Array = [start];
-        if (rest.length > 0) hull.push(rest[0]);
-
-        for (var i:int = 1; i < rest.length; ++i) {
-            var q:Object = rest[i];
-            while (hull.length > 1 && ccw(hull[hull.length - 2], hull[hull.length - 1], q) <= 0) {
-                hull.pop();
-            }
-            hull.push(q);
-        }
-        // optionnel : fermer (pas nécessaire pour le JSON si tu traces en boucle)
+        var hull:Array = monotoneChain(keys);
+        if (hull.length < 3) return [];
+        if (shrinkPx > 0) hull = shrinkPolygonTowardCentroid(hull, shrinkPx);
         return hull;
     }
 
-    private function ccw(a:Object, b:Object, c:Object):Number {
-        return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+// Chaîne monotone d'Andrew sur des clés triées x<<16|y -> hull Array<{x,y}> (aire signée > 0 dans le repère pixel)
+    private static function monotoneChain(keys:Array):Array {
+        var n:int = keys.length, k:int = 0;
+        var hx:Vector.<int> = new Vector.<int>(2 * n, true);
+        var hy:Vector.<int> = new Vector.<int>(2 * n, true);
+        var i:int, x:int, y:int;
+        for (i = 0; i < n; ++i) {                       // demi-enveloppe basse
+            x = keys[i] >>> 16; y = keys[i] & 0xFFFF;
+            while (k >= 2 && (hx[k - 1] - hx[k - 2]) * (y - hy[k - 2]) - (hy[k - 1] - hy[k - 2]) * (x - hx[k - 2]) <= 0) --k;
+            hx[k] = x; hy[k] = y; ++k;
+        }
+        var lower:int = k + 1;
+        for (i = n - 2; i >= 0; --i) {                  // demi-enveloppe haute
+            x = keys[i] >>> 16; y = keys[i] & 0xFFFF;
+            while (k >= lower && (hx[k - 1] - hx[k - 2]) * (y - hy[k - 2]) - (hy[k - 1] - hy[k - 2]) * (x - hx[k - 2]) <= 0) --k;
+            hx[k] = x; hy[k] = y; ++k;
+        }
+        var out:Array = [];
+        for (i = 0; i < k - 1; ++i) out.push({x: hx[i], y: hy[i]});   // le dernier point = le premier
+        return out;
     }
 
-// Petit "inset" (réduit légèrement le polygone pour ignorer l'AA des bords)
     private function shrinkPolygonTowardCentroid(poly:Array, px:Number):Array {
         if (poly.length < 3 || px <= 0) return poly;
         var cx:Number = 0, cy:Number = 0;
@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+# Métadonnées SWF: JSON (indenté ou minifié) ou binaire compact .swfb écrit par Exporter.as (META=bin).
+# load()/save() manipulent le même dict que le JSON, quel que soit le format sur disque.
+#   python swfmeta.py 431.json 431.swfb     # conversion (+ tailles et temps de parse)
+#
+# Format .swfb (little-endian), version 1:
+#   "SWFB" u16 version, u16 flags(0), f32 fps, f32 scale, u16 padding, u16 atlasW, u16 atlasH
+#   u16 nStrings, puis nStrings x (u16 len, UTF-8)            -- table de chaînes, index u16
+#   u16 swf
+#   u16 nPages, nPages x (u16 path, u16 format|0xFFFF)
+#   u16 nSymbols, par symbole:
+#     u16 name, u16 export, u16 type
+#     u16 nLabels x (u16 name, u16 frame)
+#     u16 nOwnPages x (u16 path, u16 format|0xFFFF)           -- mode perSymbol
+#     u16 nPageSet x u16
+#     u16 nFrames, par frame:
+#       u16 idx, u16 page, i16 x, y, w, h, ox, oy, u16 duration, u8 flags (1 = rot, 2 = poly imbriqués, 4 = tuiles)
+#       u8 nPolys, par polygone: u16 n (bit 15 = coords i16, sinon u8), n x (x, y)
+#       si flags & 4: u16 nTiles, nTiles x (u16 dx, dy, page, x, y, u8 w, h)   -- repack_atlas.py --tiles
+import json, struct, sys, time
+from pathlib import Path
+
+MAGIC = b"SWFB"
+VERSION = 1
+NO_STRING = 0xFFFF
+FLAG_ROT = 1
+FLAG_NESTED_POLY = 2
+FLAG_TILES = 4
+POLY_I16 = 0x8000
+
+# ---------------- écriture ----------------
+class _Writer:
+    def __init__(self):
+        self.out = bytearray()
+        self.strings, self.index = [], {}
+
+    def s(self, value) -> int:
+        if value is None:
+            return NO_STRING
+        value = str(value)
+        if value not in self.index:
+            if len(self.strings) >= NO_STRING:
+                raise ValueError("swfb: too many strings")
+            self.index[value] = len(self.strings)
+            self.strings.append(value)
+        return self.index[value]
+
+    def pack(self, fmt: str, *values):
+        self.out += struct.pack("<" + fmt, *values)
+
+def _polys(poly) -> tuple:
+    # JSON: [ {x,y}... ] (un polygone) ou [ [ {x,y}... ], ... ]
+    if not poly:
+        return [], False
+    if isinstance(poly[0], dict):
+        return [poly], False
+    return [p or [] for p in poly], True
+
+def encode(meta: dict) -> bytes:
+    w = _Writer()
+    atlas = meta.get("atlasSize") or {}
+    w.pack("HHffHHH", VERSION, 0, float(meta.get("fps", 24)), float(meta.get("scale", 1)),
+           int(meta.get("padding", 0)), int(atlas.get("w", 0)), int(atlas.get("h", 0)))
+
+    def pages(refs, formats):
+        w.pack("H", len(refs))
+        for i, ref in enumerate(refs):
+            fmt = formats[i] if formats and i < len(formats) else None
+            w.pack("HH", w.s(ref), w.s(fmt))
+
+    w.pack("H", w.s(meta.get("swf", "")))
+    pages(meta.get("pages") or [], meta.get("pageFormats"))
+    symbols = meta.get("symbols") or []
+    w.pack("H", len(symbols))
+    for sym in symbols:
+        w.pack("HHH", w.s(sym.get("name", "")), w.s(sym.get("export", "")), w.s(sym.get("type", "")))
+        labels = sym.get("labels") or []
+        w.pack("H", len(labels))
+        for lb in labels:
+            w.pack("HH", w.s(lb.get("name", "")), int(lb.get("frame", 0)))
+        pages(sym.get("pages") or [], sym.get("pageFormats"))
+        page_set = sym.get("pageSet") or []
+        w.pack("H" * (1 + len(page_set)), len(page_set), *page_set)
+        frames = sym.get("frames") or []
+        w.pack("H", len(frames))
+        for f in frames:
+            polys, nested = _polys(f.get("poly"))
+            flags = (FLAG_ROT if f.get("rot") else 0) | (FLAG_NESTED_POLY if nested else 0) \
+                | (FLAG_TILES if "tiles" in f else 0)
+            w.pack("HHhhhhhhHB", int(f.get("idx", 0)), int(f.get("page", 0)),
+                   int(f["x"]), int(f["y"]), int(f["w"]), int(f["h"]),
+                   int(round(f.get("ox", 0))), int(round(f.get("oy", 0))), int(f.get("duration", 1)), flags)
+            w.pack("B", len(polys))
+            for p in polys:
+                coords = [int(round(c)) for pt in p for c in (pt["x"], pt["y"])]
+                wide = any(c < 0 or c > 255 for c in coords)
+                w.pack("H", len(p) | (POLY_I16 if wide else 0))
+                w.pack(("h" if wide else "B") * len(coords), *coords)
+            if "tiles" in f:
+                w.pack("H", len(f["tiles"]))
+                for t in f["tiles"]:
+                    w.pack("HHHHHBB", *t)
+
+    table = bytearray(struct.pack("<H", len(w.strings)))
+    for s in w.strings:
+        b = s.encode("utf-8")
+        table += struct.pack("<H", len(b)) + b
+    # la table de chaînes précède le corps (le lecteur la résout une fois)
+    return MAGIC + bytes(w.out[:18]) + bytes(table) + bytes(w.out[18:])
+
+# ---------------- lecture ----------------
+def decode(data: bytes) -> dict:
+    if data[:4] != MAGIC:
+        raise ValueError("swfb: bad magic")
+    pos = 4
+
+    def rd(fmt: str):
+        nonlocal pos
+        v = struct.unpack_from("<" + fmt, data, pos)
+        pos += struct.calcsize("<" + fmt)
+        return v
+
+    version, _, fps, scale, padding, aw, ah = rd("HHffHHH")
+    if version != VERSION:
+        raise ValueError(f"swfb: unsupported version {version}")
+    strings = []
+    for _ in range(rd("H")[0]):
+        n = rd("H")[0]
+        strings.append(data[pos:pos + n].decode("utf-8"))
+        pos += n
+    s = lambda i: None if i == NO_STRING else strings[i]
+
+    def pages():
+        refs, fmts = [], []
+        for _ in range(rd("H")[0]):
+            ref, fmt = rd("HH")
+            refs.append(s(ref))
+            fmts.append(s(fmt))
+        return refs, fmts
+
+    meta = {"swf": s(rd("H")[0]), "fps": fps, "scale": scale, "padding": padding, "atlasSize": {"w": aw, "h": ah}}
+    refs, fmts = pages()
+    meta["pages"] = refs
+    if any(fmts):
+        meta["pageFormats"] = fmts
+    meta["symbols"] = []
+    for _ in range(rd("H")[0]):
+        name, export, kind = rd("HHH")
+        sym = {"name": s(name), "export": s(export), "type": s(kind), "labels": []}
+        for _ in range(rd("H")[0]):
+            ln, lf = rd("HH")
+            sym["labels"].append({"name": s(ln), "frame": lf})
+        refs, fmts = pages()
+        if refs:
+            sym["pages"] = refs
+            if any(fmts):
+                sym["pageFormats"] = fmts
+        n = rd("H")[0]
+        sym["pageSet"] = list(rd("H" * n)) if n else []
+        frames = []
+        for _ in range(rd("H")[0]):
+            idx, page, x, y, fw, fh, ox, oy, duration, flags = rd("HHhhhhhhHB")
+            f = {"idx": idx, "page": page, "x": x, "y": y, "w": fw, "h": fh, "ox": ox, "oy": oy, "duration": duration}
+            if flags & FLAG_ROT:
+                f["rot"] = 1
+            polys = []
+            for _ in range(rd("B")[0]):
+                head = rd("H")[0]
+                cnt = head & ~POLY_I16
+                c = rd(("h" if head & POLY_I16 else "B") * (cnt * 2))
+                polys.append([{"x": c[i], "y": c[i + 1]} for i in range(0, len(c), 2)])
+            if polys:
+                f["poly"] = polys if flags & FLAG_NESTED_POLY else polys[0]
+            if flags & FLAG_TILES:
+                f["tiles"] = [list(rd("HHHHHBB")) for _ in range(rd("H")[0])]
+            frames.append(f)
+        sym["frames"] = frames
+        meta["symbols"].append(sym)
+    return meta
+
+# ---------------- fichiers ----------------
+def is_meta_file(path: Path) -> bool:
+    return path.suffix.lower() in (".json", ".swfb")
+
+def load(path: Path) -> dict:
+    path = Path(path)
+    if path.suffix.lower() == ".swfb":
+        return decode(path.read_bytes())
+    return json.loads(path.read_text(encoding="utf-8"))
+
+def is_pretty(path: Path) -> bool:
+    """JSON indenté (sortie historique de l'exporteur) ou minifié (META=min)"""
+    path = Path(path)
+    with open(path, "rb") as fp:
+        return b"\n" in fp.read(4096)
+
+def save(path: Path, meta: dict, pretty: bool = None):
+    """Réécrit dans le format du fichier: .swfb binaire; .json indenté ou minifié comme l'original"""
+    path = Path(path)
+    if path.suffix.lower() == ".swfb":
+        path.write_bytes(encode(meta))
+        return
+    if pretty is None:
+        pretty = is_pretty(path) if path.exists() else True
+    text = json.dumps(meta, indent=2) if pretty else json.dumps(meta, separators=(",", ":"))
+    path.write_text(text, encoding="utf-8")
+
+def main():
+    if len(sys.argv) != 3:
+        raise SystemExit("usage: swfmeta.py <in.json|in.swfb> <out.json|out.min.json|out.swfb>")
+    src, dst = Path(sys.argv[1]), Path(sys.argv[2])
+    meta = load(src)
+    save(dst, meta, pretty=not dst.name.endswith(".min.json"))
+    t0 = time.perf_counter()
+    load(dst)
+    print(f"{src.name}: {src.stat().st_size} bytes -> {dst.name}: {dst.stat().st_size} bytes "
+          f"({src.stat().st_size / max(1, dst.stat().st_size):.1f}x), parse {1000 * (time.perf_counter() - t0):.1f} ms")
+
+if __name__ == "__main__":
+    main()
@@ -3,6 +3,7 @@
 
 #include "raygui.h"
 #include "raylib.h"
+#include "rlgl.h"
 #include "physfs.h"
 #include "cJSON.h"
 
@@ -10,16 +11,62 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <ctype.h>
+#include <math.h>
+#include <time.h>
+#include <stdint.h>
 #if defined(_WIN32)
     #include <direct.h>
+    #include <sys/utime.h>
 #else
     #include <sys/stat.h>
     #include <sys/types.h>
+    #include <utime.h>
 #endif
 
+// GL 1.1 (exporté directement par opengl32/libGL, pas de loader nécessaire) :
+// raylib n'expose pas GL_TEXTURE_MAX_LEVEL, requis pour les chaînes de mips tronquées
+#if defined(_WIN32)
+    #define GLAPIENTRY __stdcall
+#else
+    #define GLAPIENTRY
+#endif
+#define GL_TEXTURE_2D        0x0DE1
+#define GL_TEXTURE_MAX_LEVEL 0x813D
+extern void GLAPIENTRY glBindTexture(unsigned int target, unsigned int texture);
+extern void GLAPIENTRY glTexParameteri(unsigned int target, unsigned int pname, int param);
+extern void GLAPIENTRY glGenTextures(int n, unsigned int* textures);
+extern void GLAPIENTRY glDeleteTextures(int n, const unsigned int* textures);
+
+// GL 3.x (tableaux de textures): hors GL 1.1, résolus via GLFW après InitWindow (cf. InitPageArrays)
+#define GL_TEXTURE0                0x84C0
+#define GL_TEXTURE_2D_ARRAY        0x8C1A
+#define GL_TEXTURE_MAG_FILTER      0x2800
+#define GL_TEXTURE_MIN_FILTER      0x2801
+#define GL_TEXTURE_WRAP_S          0x2802
+#define GL_TEXTURE_WRAP_T          0x2803
+#define GL_NEAREST                 0x2600
+#define GL_LINEAR                  0x2601
+#define GL_LINEAR_MIPMAP_LINEAR    0x2703
+#define GL_CLAMP_TO_EDGE           0x812F
+typedef void (*GlProc)(void);
+extern GlProc glfwGetProcAddress(const char* procname);
+typedef void (GLAPIENTRY *PfnTexImage3D)(unsigned int target, int level, int internalFormat, int w, int h, int depth,
+                                         int border, unsigned int format, unsigned int type, const void* pixels);
+typedef void (GLAPIENTRY *PfnCompressedTexImage3D)(unsigned int target, int level, unsigned int internalFormat, int w, int h,
+                                                   int depth, int border, int imageSize, const void* data);
+typedef void (GLAPIENTRY *PfnActiveTexture)(unsigned int texture);
+static PfnTexImage3D pglTexImage3D = NULL;
+static PfnCompressedTexImage3D pglCompressedTexImage3D = NULL;
+static PfnActiveTexture pglActiveTexture = NULL;
+
 static bool gShowAtlas = false;
 static bool gIgnoreOffsets = false;
 static bool gDrawHit = true;   // en haut, global
+static bool gPageArrays = false; // L : pages d'un pack dans un seul GL_TEXTURE_2D_ARRAY (rechargement du pack)
+static bool gMeshes = false;     // M : frames dessinées avec leur maillage serré (hull) au lieu du quad w x h
+static bool gHeatmap = false;    // F : carte d'overdraw (passe de comptage additive) + stats de fill-rate
+static bool gCountPass = false;  // vrai pendant la passe de comptage: les shaders de page écrivent des compteurs
 
 
 // ---------------- small utils ----------------
@@ -76,44 +123,365 @@ static void EnsureDirExists(const char* dir) {
 #endif
 }
 
+// --------------- threads (préchargement) --------------
+// Un thread ouvrier lit et décode ce que le préchargement demande; GL reste sur le thread principal.
+// Pas de <windows.h> (conflits de noms avec raylib: Rectangle, CloseWindow, DrawText...): les quelques
+// fonctions Win32 utiles sont déclarées ici, comme GL plus haut. SRWLOCK/CONDITION_VARIABLE = un
+// pointeur, initialisés à zéro.
+#if defined(_WIN32)
+    #include <process.h>
+    typedef struct { void* p; } SyncLock;
+    typedef struct { void* p; } SyncCond;
+    typedef uintptr_t WorkerThread;
+    #define SYNC_LOCK_INIT {0}
+    #define SYNC_COND_INIT {0}
+    #define THREAD_PROC(name) static unsigned __stdcall name(void* arg)
+    typedef unsigned (__stdcall *ThreadProc)(void*);
+    __declspec(dllimport) void __stdcall AcquireSRWLockExclusive(SyncLock* lock);
+    __declspec(dllimport) void __stdcall ReleaseSRWLockExclusive(SyncLock* lock);
+    __declspec(dllimport) int __stdcall SleepConditionVariableSRW(SyncCond* cond, SyncLock* lock, unsigned long ms, unsigned long flags);
+    __declspec(dllimport) void __stdcall WakeConditionVariable(SyncCond* cond);
+    __declspec(dllimport) unsigned long __stdcall WaitForSingleObject(void* handle, unsigned long ms);
+    __declspec(dllimport) int __stdcall CloseHandle(void* handle);
+    static void SyncLockAcquire(SyncLock* l) { AcquireSRWLockExclusive(l); }
+    static void SyncLockRelease(SyncLock* l) { ReleaseSRWLockExclusive(l); }
+    static void SyncCondWait(SyncCond* c, SyncLock* l) { SleepConditionVariableSRW(c, l, 0xFFFFFFFFu, 0); }
+    static void SyncCondSignal(SyncCond* c) { WakeConditionVariable(c); }
+    static bool ThreadStart(WorkerThread* t, ThreadProc fn) { *t = _beginthreadex(NULL, 0, fn, NULL, 0, NULL); return *t != 0; }
+    static void ThreadJoin(WorkerThread t) { WaitForSingleObject((void*)t, 0xFFFFFFFFu); CloseHandle((void*)t); }
+#else
+    #include <pthread.h>
+    typedef pthread_mutex_t SyncLock;
+    typedef pthread_cond_t SyncCond;
+    typedef pthread_t WorkerThread;
+    #define SYNC_LOCK_INIT PTHREAD_MUTEX_INITIALIZER
+    #define SYNC_COND_INIT PTHREAD_COND_INITIALIZER
+    #define THREAD_PROC(name) static void* name(void* arg)
+    typedef void* (*ThreadProc)(void*);
+    static void SyncLockAcquire(SyncLock* l) { pthread_mutex_lock(l); }
+    static void SyncLockRelease(SyncLock* l) { pthread_mutex_unlock(l); }
+    static void SyncCondWait(SyncCond* c, SyncLock* l) { pthread_cond_wait(c, l); }
+    static void SyncCondSignal(SyncCond* c) { pthread_cond_signal(c); }
+    static bool ThreadStart(WorkerThread* t, ThreadProc fn) { return pthread_create(t, NULL, fn, NULL) == 0; }
+    static void ThreadJoin(WorkerThread t) { pthread_join(t, NULL); }
+#endif
+
+
+// Pages mipmappées: convert_and_pack.py s'arrête au dernier niveau que la gouttière entre frames
+// supporte, la chaîne n'atteint donc pas forcément 1x1. Sans MAX_LEVEL la texture serait
+// "incomplète" pour GL (échantillonnée noire) dès que le filtre min utilise les mips.
+static void SetupPageMipmaps(Texture2D tex) {
+    if (!tex.id || tex.mipmaps <= 1) return;
+    glBindTexture(GL_TEXTURE_2D, tex.id);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, tex.mipmaps - 1);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    SetTextureFilter(tex, TEXTURE_FILTER_TRILINEAR);   // LOD choisi par le GPU selon l'échelle d'affichage
+}
+
+// Page "PAL8" (convert_and_pack.py --palette): DDS P8 = en-tête 128 octets, palette 256 x RGBA, index 8 bits.
+// raylib ne lit pas ce format: index -> texture GRAYSCALE (R8), palette -> texture 256x1, toutes deux
+// en filtrage POINT; le shader palette fait la recherche et l'interpolation bilinéaire des couleurs.
+#define DDPF_PALETTEINDEXED8 0x20
+// data: fichier lu en entier (libéré ici); le thread de préchargement ne fait que la lecture
+static Texture2D LoadPalettePageFromData(const char* path, unsigned char* data, int sz, Texture2D* palette) {
+    *palette = (Texture2D){0};
+    if (!data) return (Texture2D){0};
+    int h = 0, w = 0;
+    unsigned int pfFlags = 0;
+    if (sz >= 128) {
+        memcpy(&h, data + 12, 4);
+        memcpy(&w, data + 16, 4);
+        memcpy(&pfFlags, data + 80, 4);
+    }
+    if (sz < 128 || memcmp(data, "DDS ", 4) != 0 || !(pfFlags & DDPF_PALETTEINDEXED8)
+            || w <= 0 || h <= 0 || sz < 128 + 1024 + w * h) {
+        TraceLog(LOG_ERROR, "Not a P8 DDS: %s", path);
+        MemFree(data);
+        return (Texture2D){0};
+    }
+    Image idx = { data + 128 + 1024, w, h, 1, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE };
+    Image pal = { data + 128, 256, 1, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    Texture2D tex = LoadTextureFromImage(idx);
+    *palette = LoadTextureFromImage(pal);
+    MemFree(data);
+    if (!tex.id || !palette->id) TraceLog(LOG_ERROR, "PAL8 upload failed: %s", path);
+    else TraceLog(LOG_INFO, "PAL8 Texture OK: %s  -> %dx%d", path, tex.width, tex.height);
+    return tex;
+}
 
-static Texture2D LoadTextureFromPak(const char* path) {
+static Texture2D LoadPalettePageFromPak(const char* path, Texture2D* palette) {
     int sz = 0;
     unsigned char* data = ReadAllPhysFS(path, &sz);
-    if (!data) return (Texture2D){0};
+    return LoadPalettePageFromData(path, data, sz, palette);
+}
 
-    // If it's a DDS, write to a cache file and let raylib load it as a texture
-    const char* ext = strrchr(path, '.');
-    if (ext && (strcasecmp(ext, ".dds") == 0)) {
-        // cache path: ./.cache_textures/<original_name>.dds
-        EnsureDirExists(".cache_textures");
-        char outPath[512];
-        snprintf(outPath, sizeof(outPath), ".cache_textures/%s", path); // keep the same name
-        // ensure subdirs not present in DDS names: if your paths include folders, sanitize here if needed
-
-        // write file
-        FILE* fp = fopen(outPath, "wb");
-        if (!fp) { MemFree(data); TraceLog(LOG_ERROR, "Temp write failed: %s", outPath); return (Texture2D){0}; }
-        fwrite(data, 1, (size_t)sz, fp);
-        fclose(fp);
-        MemFree(data);
+// --------------- cache disque des texels décodés --------------
+// Une entrée par contenu d'entrée de pak: clé = CRC32 + taille lues dans le répertoire central du zip
+// (sans rien décompresser), valeur = texels prêts pour le GPU (blocs BC tels quels, PNG déjà décodé
+// en RGBA8, mips comprises). Une page modifiée change de clé: l'ancienne entrée n'est plus lue et
+// part à l'éviction (LRU sur la date de modif., touchée à chaque hit) dès que TEXCACHE_BUDGET_MB est dépassé
+// (total tenu à jour à chaque écriture: le dossier n'est relu qu'au démarrage et au dépassement).
+// Pack monté depuis un dossier (pas un zip) => pas de clé, pas de cache.
+#define TEXCACHE_DIR       ".cache_textures"
+#define TEXCACHE_BUDGET_MB 1024
+#define TEXCACHE_MAGIC     0x43545753u   // "SWTC"
+#define TEXCACHE_VERSION   1u
+#define TEXCACHE_PART_MAX_AGE 3600   // s: un .part plus vieux vient d'un viewer interrompu (sinon écriture en cours)
 
-        // load gpu texture directly (compressed BC3/DXT5 kept on GPU)
-        Texture2D tex = LoadTexture(outPath);
-        if (!tex.id) TraceLog(LOG_ERROR, "LoadTexture failed: %s", outPath);
-        else         TraceLog(LOG_INFO, "DDS Texture OK: %s  -> %dx%d", path, tex.width, tex.height);
-        return tex;
+typedef struct {
+    unsigned int magic, version, crc, size;   // crc/size: entrée du pak d'origine
+    int width, height, mipmaps, format;       // Image raylib
+    unsigned int dataSize;
+} TexCacheHeader;
+
+typedef struct { char* pak; int count; char** names; unsigned int* crc; unsigned int* size; } ZipDir;
+static ZipDir* gZipDirs = NULL;
+static int gZipDirCount = 0;
+static int gTexCacheHits = 0, gTexCacheMisses = 0;
+static long long gTexCacheBytes = 0;   // taille totale des .tex, recalculée à chaque scan du dossier
+static unsigned int gTexCacheSerial = 0;   // suffixe des .part: deux threads peuvent écrire la même entrée
+// répertoires de zip, compteurs et total du cache: partagés avec le thread de préchargement
+static SyncLock gIoLock = SYNC_LOCK_INIT;
+
+static unsigned int Le16(const unsigned char* p) { return p[0] | (p[1] << 8); }
+static unsigned int Le32(const unsigned char* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24); }
+
+// répertoire central d'un zip (EOCD classique, pas de zip64: les paks restent sous 4 Go)
+static ZipDir LoadZipDir(const char* pak) {
+    ZipDir d = { TextDuplicate(pak), 0, NULL, NULL, NULL };
+    FILE* fp = fopen(pak, "rb");
+    if (!fp) return d;
+    fseek(fp, 0, SEEK_END);
+    long fileSize = ftell(fp);
+    long tailSize = fileSize < 65557 ? fileSize : 65557;   // EOCD (22) + commentaire max (65535)
+    unsigned char* tail = (unsigned char*)MemAlloc((unsigned int)tailSize);
+    fseek(fp, fileSize - tailSize, SEEK_SET);
+    long eocd = -1;
+    if (fread(tail, 1, (size_t)tailSize, fp) == (size_t)tailSize)
+        for (long i = tailSize - 22; i >= 0 && eocd < 0; --i)
+            if (Le32(tail + i) == 0x06054b50u) eocd = i;
+    if (eocd >= 0) {
+        int count = (int)Le16(tail + eocd + 10);
+        unsigned int cdSize = Le32(tail + eocd + 12), cdOff = Le32(tail + eocd + 16);
+        unsigned char* cd = (unsigned char*)MemAlloc(cdSize + 1);
+        fseek(fp, (long)cdOff, SEEK_SET);
+        if (fread(cd, 1, cdSize, fp) == cdSize) {
+            d.names = (char**)MemAlloc(sizeof(char*) * (count > 0 ? count : 1));
+            d.crc = (unsigned int*)MemAlloc(sizeof(unsigned int) * (count > 0 ? count : 1));
+            d.size = (unsigned int*)MemAlloc(sizeof(unsigned int) * (count > 0 ? count : 1));
+            unsigned int off = 0;
+            for (int i = 0; i < count && off + 46 <= cdSize && Le32(cd + off) == 0x02014b50u; ++i) {
+                unsigned int nameLen = Le16(cd + off + 28), extraLen = Le16(cd + off + 30), commentLen = Le16(cd + off + 32);
+                if (off + 46 + nameLen > cdSize) break;
+                char* name = (char*)MemAlloc(nameLen + 1);
+                memcpy(name, cd + off + 46, nameLen);
+                d.names[d.count] = name;
+                d.crc[d.count] = Le32(cd + off + 16);
+                d.size[d.count] = Le32(cd + off + 24);
+                d.count++;
+                off += 46 + nameLen + extraLen + commentLen;
+            }
+        }
+        MemFree(cd);
     }
+    MemFree(tail);
+    fclose(fp);
+    return d;
+}
 
-    // Fallback for PNG/JPG/etc. → Image path
-    Image img = LoadImageFromMemory(ext ? ext : ".png", data, sz);
-    MemFree(data);
-    if (!img.data) { TraceLog(LOG_ERROR, "LoadImageFromMemory failed: %s", path); return (Texture2D){0}; }
+static void FreeZipDirs(void) {
+    for (int i = 0; i < gZipDirCount; ++i) {
+        for (int k = 0; k < gZipDirs[i].count; ++k) MemFree(gZipDirs[i].names[k]);
+        if (gZipDirs[i].names) { MemFree(gZipDirs[i].names); MemFree(gZipDirs[i].crc); MemFree(gZipDirs[i].size); }
+        MemFree(gZipDirs[i].pak);
+    }
+    if (gZipDirs) MemFree(gZipDirs);
+    gZipDirs = NULL;
+    gZipDirCount = 0;
+}
+
+// clé de cache d'un fichier monté: CRC/taille de l'entrée dans le pak qui le fournit (false si dossier)
+static bool PakEntryKey(const char* path, unsigned int* crc, unsigned int* size) {
+    const char* pak = PHYSFS_getRealDir(path);
+    if (!pak || !EndsWith(pak, ".pak")) return false;
+    SyncLockAcquire(&gIoLock);
+    bool found = false;
+    ZipDir* d = NULL;
+    for (int i = 0; i < gZipDirCount && !d; ++i) if (strcmp(gZipDirs[i].pak, pak) == 0) d = &gZipDirs[i];
+    if (!d) {
+        gZipDirs = (ZipDir*)MemRealloc(gZipDirs, sizeof(ZipDir) * (gZipDirCount + 1));
+        gZipDirs[gZipDirCount] = LoadZipDir(pak);
+        d = &gZipDirs[gZipDirCount++];
+    }
+    const char* name = path[0] == '/' ? path + 1 : path;
+    for (int i = 0; i < d->count && !found; ++i) {
+        if (strcmp(d->names[i], name) == 0) { *crc = d->crc[i]; *size = d->size[i]; found = true; }
+    }
+    SyncLockRelease(&gIoLock);
+    return found;
+}
+
+static unsigned int ImageDataSize(Image img) {
+    unsigned int bytes = 0;
+    for (int m = 0, w = img.width, h = img.height; m < (img.mipmaps > 0 ? img.mipmaps : 1); ++m, w = w > 1 ? w/2 : 1, h = h > 1 ? h/2 : 1)
+        bytes += (unsigned int)GetPixelDataSize(w, h, img.format);
+    return bytes;
+}
+
+static void TexCachePath(char* out, int outSize, unsigned int crc, unsigned int size) {
+    snprintf(out, outSize, TEXCACHE_DIR "/%08x_%u.tex", crc, size);
+}
+
+// entrée valide => Image (data à libérer par UnloadImage); entrée illisible ou d'une autre version => supprimée
+static Image TexCacheLoad(unsigned int crc, unsigned int size) {
+    char cachePath[256];
+    TexCachePath(cachePath, sizeof(cachePath), crc, size);
+    FILE* fp = fopen(cachePath, "rb");
+    if (!fp) return (Image){0};
+    TexCacheHeader h;
+    Image img = {0};
+    bool ok = fread(&h, sizeof(h), 1, fp) == 1 && h.magic == TEXCACHE_MAGIC && h.version == TEXCACHE_VERSION
+              && h.crc == crc && h.size == size && h.width > 0 && h.height > 0;
+    if (ok) {
+        img = (Image){ NULL, h.width, h.height, h.mipmaps, h.format };
+        ok = ImageDataSize(img) == h.dataSize;
+    }
+    if (ok) {
+        img.data = MemAlloc(h.dataSize);
+        ok = fread(img.data, 1, h.dataSize, fp) == h.dataSize;
+    }
+    fclose(fp);
+    if (!ok) {
+        if (img.data) MemFree(img.data);
+        long long stale = GetFileLength(cachePath);
+        if (remove(cachePath) == 0) {
+            SyncLockAcquire(&gIoLock);
+            gTexCacheBytes -= stale;
+            SyncLockRelease(&gIoLock);
+        }
+        TraceLog(LOG_WARNING, "TexCache: stale entry %s evicted", cachePath);
+        return (Image){0};
+    }
+    utime(cachePath, NULL);   // LRU: date de dernier accès
+    return img;
+}
+
+typedef struct { char* path; long long size; long mtime; } TexCacheEntry;
+
+static int CompareTexCacheEntry(const void* a, const void* b) {
+    long ma = ((const TexCacheEntry*)a)->mtime, mb = ((const TexCacheEntry*)b)->mtime;
+    return (ma > mb) - (ma < mb);
+}
+
+// Scan du dossier (au démarrage, puis seulement quand le total courant dépasse le budget): recale
+// gTexCacheBytes, supprime les restes de l'ancien cache par nom et les .part abandonnés, puis évince
+// les entrées les moins récemment utilisées jusqu'à 90% du budget (pas de nouveau scan au store suivant).
+// Un seul stat par fichier, tri par date. Deux scans concurrents (thread de préchargement) ne gênent
+// pas: un fichier déjà supprimé par l'autre n'est pas décompté.
+static void TexCacheEnforceBudget(void) {
+    FilePathList list = LoadDirectoryFiles(TEXCACHE_DIR);
+    TexCacheEntry* entries = (TexCacheEntry*)MemAlloc(sizeof(TexCacheEntry) * (list.count ? list.count : 1));
+    long now = (long)time(NULL);
+    long long total = 0;
+    int n = 0;
+    for (unsigned int i = 0; i < list.count; ++i) {
+        char* path = list.paths[i];
+        if (EndsWith(path, ".part")) {
+            // .part récent: écriture en cours d'un autre viewer, à laisser
+            if (now - GetFileModTime(path) > TEXCACHE_PART_MAX_AGE) remove(path);
+            continue;
+        }
+        if (!EndsWith(path, ".tex")) { remove(path); continue; }
+        entries[n] = (TexCacheEntry){ path, GetFileLength(path), GetFileModTime(path) };
+        total += entries[n++].size;
+    }
+    long long budget = (long long)TEXCACHE_BUDGET_MB * 1024 * 1024;
+    if (total > budget) {
+        qsort(entries, (size_t)n, sizeof(TexCacheEntry), CompareTexCacheEntry);
+        for (int i = 0; i < n && total > budget / 10 * 9; ++i) {
+            TraceLog(LOG_INFO, "TexCache: evict %s (over %d MB)", entries[i].path, TEXCACHE_BUDGET_MB);
+            if (remove(entries[i].path) == 0) total -= entries[i].size;
+        }
+    }
+    SyncLockAcquire(&gIoLock);
+    gTexCacheBytes = total;
+    SyncLockRelease(&gIoLock);
+    MemFree(entries);
+    UnloadDirectoryFiles(list);
+}
+
+static void TexCacheStore(unsigned int crc, unsigned int size, Image img) {
+    EnsureDirExists(TEXCACHE_DIR);
+    char cachePath[256], tmpPath[272];
+    TexCachePath(cachePath, sizeof(cachePath), crc, size);
+    SyncLockAcquire(&gIoLock);
+    unsigned int serial = ++gTexCacheSerial;
+    SyncLockRelease(&gIoLock);
+    snprintf(tmpPath, sizeof(tmpPath), "%s.%u.part", cachePath, serial);
+    TexCacheHeader h = { TEXCACHE_MAGIC, TEXCACHE_VERSION, crc, size, img.width, img.height, img.mipmaps, img.format, ImageDataSize(img) };
+    FILE* fp = fopen(tmpPath, "wb");
+    if (!fp) { TraceLog(LOG_WARNING, "TexCache: cannot write %s", tmpPath); return; }
+    bool ok = fwrite(&h, sizeof(h), 1, fp) == 1 && fwrite(img.data, 1, h.dataSize, fp) == h.dataSize;
+    ok = (fclose(fp) == 0) && ok;
+    // écrit puis renommé: un viewer interrompu ne laisse pas d'entrée tronquée sous le vrai nom
+    long long replaced = GetFileLength(cachePath);
+    if (remove(cachePath) != 0) replaced = 0;
+    if (!ok || rename(tmpPath, cachePath) != 0) { remove(tmpPath); ok = false; }
+    SyncLockAcquire(&gIoLock);
+    gTexCacheBytes += (ok ? (long long)sizeof(h) + h.dataSize : 0) - replaced;
+    bool over = gTexCacheBytes > (long long)TEXCACHE_BUDGET_MB * 1024 * 1024;
+    SyncLockRelease(&gIoLock);
+    if (over) TexCacheEnforceBudget();
+}
 
+// formatHint: entrée "pageFormats" du JSON ("BC1", "BC3", "BC7"...), NULL si absente
+// Image CPU d'une page (DDS gardé compressé, mips compris), data NULL si échec
+static Image LoadPageImageFromPak(const char* path, const char* formatHint) {
+    unsigned int crc = 0, size = 0;
+    bool keyed = PakEntryKey(path, &crc, &size);
+    Image img = keyed ? TexCacheLoad(crc, size) : (Image){0};
+    if (img.data) {
+        SyncLockAcquire(&gIoLock);
+        gTexCacheHits++;
+        SyncLockRelease(&gIoLock);
+    } else {
+        int sz = 0;
+        unsigned char* data = ReadAllPhysFS(path, &sz);
+        if (!data) return (Image){0};
+        // DDS: blocs BC gardés compressés pour le GPU; PNG/JPG/etc.: décodé en RGBA
+        const char* ext = strrchr(path, '.');
+        img = LoadImageFromMemory((ext && strcasecmp(ext, ".dds") == 0) ? ".dds" : (ext ? ext : ".png"), data, sz);
+        MemFree(data);
+        if (!img.data) { TraceLog(LOG_ERROR, "LoadImageFromMemory failed: %s", path); return img; }
+        if (keyed) {
+            SyncLockAcquire(&gIoLock);
+            gTexCacheMisses++;
+            SyncLockRelease(&gIoLock);
+            TexCacheStore(crc, size, img);
+        }
+    }
+    // un DDS BC1 sans DDPF_ALPHAPIXELS (texconv) est lu en DXT1_RGB: l'alpha 1 bit serait ignoré.
+    // DXT1_RGBA décode les blocs opaques à l'identique, on l'impose dès que le pack annonce du BC1.
+    if (formatHint && strncmp(formatHint, "BC1", 3) == 0 && img.format == PIXELFORMAT_COMPRESSED_DXT1_RGB)
+        img.format = PIXELFORMAT_COMPRESSED_DXT1_RGBA;
+    return img;
+}
+
+// img décodée (ici ou par le thread de préchargement) -> texture de page; img reste à libérer
+static Texture2D UploadPageImage(const char* path, const char* formatHint, Image img) {
     Texture2D tex = LoadTextureFromImage(img);
+    SetupPageMipmaps(tex);
+    if (!tex.id) TraceLog(LOG_ERROR, "LoadTexture failed: %s", path);
+    else         TraceLog(LOG_INFO, "Texture OK: %s  -> %dx%d %s mips=%d", path, tex.width, tex.height,
+                          formatHint ? formatHint : "", tex.mipmaps);
+    return tex;
+}
+
+static Texture2D LoadTextureFromPak(const char* path, const char* formatHint) {
+    Image img = LoadPageImageFromPak(path, formatHint);
+    if (!img.data) return (Texture2D){0};
+    Texture2D tex = UploadPageImage(path, formatHint, img);
     UnloadImage(img);
-    if (!tex.id) TraceLog(LOG_ERROR, "LoadTextureFromImage failed: %s", path);
-    else         TraceLog(LOG_INFO, "Texture OK: %s  -> %dx%d", path, tex.width, tex.height);
     return tex;
 }
 
@@ -121,25 +489,261 @@ static Texture2D LoadTextureFromPak(const char* path) {
 typedef struct { int x, y, w, h; } HitRect;
 typedef struct { float x, y; } Pt;
 typedef struct { Pt* pts; int count; } Poly;
+typedef struct { int dx, dy, page, x, y, w, h; } Tile;   // dx/dy: position dans la frame, x/y/w/h: dans la page
 
 typedef struct {
     int idx, page, x, y, w, h, ox, oy, duration;
+    int rot;            // 1 = stockée tournée de 90° (horaire) dans la page : occupe h x w (repack_atlas.py --rotate)
     Poly* polys;
     int polyCount;
+    int tiled;          // 1 = frame en tuiles dédupliquées (repack_atlas.py --tiles): page/x/y ignorés
+    Tile* tiles;        // triées par page
+    int tileCount;
+    Pt* mesh;           // hull dilaté et découpé à 0..w x 0..h, dessiné en éventail (NULL => quad)
+    int meshCount;
+    float meshArea;     // px couverts par le maillage (w*h sans maillage)
 } Frame;
 typedef struct {
     const char* name; // symbol name
     Frame* frames;
     int frameCount;
+    int* pageSet;     // pages globales utilisées par le symbole ("pageSet", sinon déduit des frames)
+    int pageSetCount;
 } Symbol;
 typedef struct {
     float fps;
     Texture2D* pages;
+    Texture2D* palettes;  // alignées sur pages: palette 256x1 des pages PAL8, id 0 sinon
     int pageCount;
+    unsigned int pageArray; // mode L: toutes les pages en GL_TEXTURE_2D_ARRAY (pages[] = descripteurs, id 0)
+    char** pagePaths;       // hors mode L: pages chargées à la demande (id 0 tant que non chargée)
+    char** pageFormats;
     Symbol* symbols;
     int symbolCount;
 } SwfPack;
 
+// page PAL8 ou DDS/PNG selon "pageFormats"
+static Texture2D LoadPageFromPak(const char* path, const char* formatHint, Texture2D* palette) {
+    *palette = (Texture2D){0};
+    if (formatHint && strcmp(formatHint, "PAL8") == 0) return LoadPalettePageFromPak(path, palette);
+    return LoadTextureFromPak(path, formatHint);
+}
+
+// Pages partagées: une page chargée une seule fois pour tous les packs qui la référencent (cache de
+// packs, même page dans deux paks). Clé = contenu (CRC/taille de l'entrée de pak) + format annoncé,
+// sinon chemin monté; la texture est libérée quand le dernier pack la rend.
+typedef struct { char* key; Texture2D tex; Texture2D palette; int refs; } SharedPage;
+static SharedPage* gSharedPages = NULL;
+static int gSharedPageCount = 0;
+
+static void PageTextureKey(const char* path, const char* formatHint, char* key, int keySize) {
+    unsigned int crc = 0, size = 0;
+    if (PakEntryKey(path, &crc, &size)) snprintf(key, keySize, "%08x_%u|%s", crc, size, formatHint ? formatHint : "");
+    else                                snprintf(key, keySize, "%s|%s", path, formatHint ? formatHint : "");
+}
+
+// page déjà chargée sous cette clé: une référence de plus
+static bool SharedPageTake(const char* key, Texture2D* tex, Texture2D* palette) {
+    for (int i = 0; i < gSharedPageCount; ++i) {
+        if (strcmp(gSharedPages[i].key, key) == 0) {
+            gSharedPages[i].refs++;
+            *palette = gSharedPages[i].palette;
+            *tex = gSharedPages[i].tex;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void SharedPageAdd(const char* key, Texture2D tex, Texture2D palette) {
+    gSharedPages = (SharedPage*)MemRealloc(gSharedPages, sizeof(SharedPage) * (gSharedPageCount + 1));
+    gSharedPages[gSharedPageCount++] = (SharedPage){ TextDuplicate(key), tex, palette, 1 };
+}
+
+static Texture2D AcquirePageTexture(const char* path, const char* formatHint, Texture2D* palette) {
+    char key[600];
+    PageTextureKey(path, formatHint, key, sizeof(key));
+    Texture2D tex;
+    if (SharedPageTake(key, &tex, palette)) return tex;
+    tex = LoadPageFromPak(path, formatHint, palette);
+    if (tex.id) SharedPageAdd(key, tex, *palette);
+    return tex;
+}
+
+static void ReleasePageTexture(Texture2D tex) {
+    for (int i = 0; i < gSharedPageCount; ++i) {
+        if (gSharedPages[i].tex.id != tex.id) continue;
+        if (--gSharedPages[i].refs > 0) return;
+        UnloadTexture(gSharedPages[i].tex);
+        if (gSharedPages[i].palette.id) UnloadTexture(gSharedPages[i].palette);
+        MemFree(gSharedPages[i].key);
+        gSharedPages[i] = gSharedPages[--gSharedPageCount];
+        return;
+    }
+    UnloadTexture(tex);   // hors registre
+}
+
+static long long TextureBytes(Texture2D t) {
+    return ImageDataSize((Image){ NULL, t.width, t.height, t.mipmaps, t.format });
+}
+
+// Pages de même taille/format (pages fixes atlasW x atlasH de l'exporteur) -> un GL_TEXTURE_2D_ARRAY:
+// plus de changement de texture entre pages, un seul lot de quads pour toute la scène.
+// Refusé (retour false => une texture par page) si une page est PAL8 ou diffère des autres.
+static bool BuildPageArray(SwfPack* sw, const char** paths, const char** formats) {
+    if (!pglTexImage3D || !pglCompressedTexImage3D || !pglActiveTexture || sw->pageCount == 0) return false;
+    for (int i = 0; i < sw->pageCount; ++i) {
+        if (!paths[i] || (formats[i] && strcmp(formats[i], "PAL8") == 0)) {
+            TraceLog(LOG_WARNING, "Page array: page %d missing or PAL8, per-page textures", i);
+            return false;
+        }
+    }
+    int n = sw->pageCount;
+    Image* imgs = (Image*)MemAlloc(sizeof(Image) * n);
+    bool ok = true;
+    for (int i = 0; i < n && ok; ++i) {
+        imgs[i] = LoadPageImageFromPak(paths[i], formats[i]);
+        if (!imgs[i].data) {
+            TraceLog(LOG_WARNING, "Page array: page %d (%s) failed to load, per-page textures", i, paths[i]);
+            ok = false;
+        } else if (i > 0 && (imgs[i].width != imgs[0].width || imgs[i].height != imgs[0].height ||
+                             imgs[i].format != imgs[0].format || imgs[i].mipmaps != imgs[0].mipmaps)) {
+            TraceLog(LOG_WARNING, "Page array: pages differ in size/format, per-page textures");
+            ok = false;
+        }
+    }
+    unsigned int internalFormat = 0, glFormat = 0, glType = 0;
+    if (ok) rlGetGlTextureFormats(imgs[0].format, &internalFormat, &glFormat, &glType);
+    if (ok && !internalFormat) {
+        TraceLog(LOG_WARNING, "Page array: pixel format %d not supported by the driver, per-page textures", imgs[0].format);
+        ok = false;
+    } else if (ok) {
+        const Image* a = &imgs[0];
+        bool compressed = a->format >= PIXELFORMAT_COMPRESSED_DXT1_RGB;
+        unsigned int id = 0;
+        glGenTextures(1, &id);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, id);
+        // un niveau de mip = les n couches à la suite
+        int offset = 0;
+        for (int m = 0, w = a->width, h = a->height; m < a->mipmaps; ++m, w = w > 1 ? w/2 : 1, h = h > 1 ? h/2 : 1) {
+            int size = GetPixelDataSize(w, h, a->format);
+            unsigned char* layers = (unsigned char*)MemAlloc((unsigned int)(size * n));
+            for (int i = 0; i < n; ++i) memcpy(layers + (size_t)i * size, (unsigned char*)imgs[i].data + offset, (size_t)size);
+            if (compressed) pglCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, m, internalFormat, w, h, n, 0, size * n, layers);
+            else            pglTexImage3D(GL_TEXTURE_2D_ARRAY, m, (int)internalFormat, w, h, n, 0, glFormat, glType, layers);
+            MemFree(layers);
+            offset += size;
+        }
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, a->mipmaps - 1);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, a->mipmaps > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, a->mipmaps > 1 ? GL_LINEAR : GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        sw->pageArray = id;
+        for (int i = 0; i < n; ++i) sw->pages[i] = (Texture2D){ 0, a->width, a->height, a->mipmaps, a->format };
+        TraceLog(LOG_INFO, "Page array: %d pages %dx%d mips=%d -> GL_TEXTURE_2D_ARRAY %u", n, a->width, a->height, a->mipmaps, id);
+    }
+    for (int i = 0; i < n; ++i) if (imgs[i].data) UnloadImage(imgs[i]);
+    MemFree(imgs);
+    return ok;
+}
+
+// pages d'un pack (pageCount déjà fixé): chemins seulement, rien n'est chargé ici (pas de GL: appelé aussi
+// par le thread de préchargement). Une texture par page à la demande, ou tableau (PackUsePageArray).
+static void LoadPackPages(SwfPack* sw, const char** paths, const char** formats) {
+    if (sw->pageCount <= 0) return;
+    sw->pages = (Texture2D*)MemAlloc(sizeof(Texture2D) * sw->pageCount);
+    sw->palettes = (Texture2D*)MemAlloc(sizeof(Texture2D) * sw->pageCount);
+    memset(sw->palettes, 0, sizeof(Texture2D) * sw->pageCount);
+    memset(sw->pages, 0, sizeof(Texture2D) * sw->pageCount);
+    sw->pagePaths = (char**)MemAlloc(sizeof(char*) * sw->pageCount);
+    sw->pageFormats = (char**)MemAlloc(sizeof(char*) * sw->pageCount);
+    for (int i = 0; i < sw->pageCount; ++i) {
+        sw->pagePaths[i] = paths[i] ? TextDuplicate(paths[i]) : NULL;
+        sw->pageFormats[i] = formats[i] ? TextDuplicate(formats[i]) : NULL;
+    }
+}
+
+// mode L: toutes les pages du pack en GL_TEXTURE_2D_ARRAY; les pages déjà chargées une à une (pack
+// préchargé) sont rendues au registre. Échec => le pack reste en pages à la demande.
+static bool PackUsePageArray(SwfPack* sw) {
+    if (sw->pageArray || !sw->pagePaths) return sw->pageArray != 0;
+    Texture2D* single = (Texture2D*)MemAlloc(sizeof(Texture2D) * sw->pageCount);
+    memcpy(single, sw->pages, sizeof(Texture2D) * sw->pageCount);
+    if (!BuildPageArray(sw, (const char**)sw->pagePaths, (const char**)sw->pageFormats)) {
+        MemFree(single);
+        return false;
+    }
+    for (int i = 0; i < sw->pageCount; ++i) {
+        if (single[i].id) ReleasePageTexture(single[i]);
+        sw->palettes[i] = (Texture2D){0};
+        if (sw->pagePaths[i]) MemFree(sw->pagePaths[i]);
+        if (sw->pageFormats[i]) MemFree(sw->pageFormats[i]);
+    }
+    MemFree(sw->pagePaths);
+    MemFree(sw->pageFormats);
+    sw->pagePaths = sw->pageFormats = NULL;
+    MemFree(single);
+    return true;
+}
+
+// charge la page si besoin; un échec oublie le chemin (pas de nouvel essai à chaque frame)
+static bool EnsurePageLoaded(SwfPack* sw, int page) {
+    if (page < 0 || page >= sw->pageCount) return false;
+    if (sw->pageArray || sw->pages[page].id) return true;
+    if (!sw->pagePaths || !sw->pagePaths[page]) return false;
+    sw->pages[page] = AcquirePageTexture(sw->pagePaths[page], sw->pageFormats[page], &sw->palettes[page]);
+    if (!sw->pages[page].id) {
+        TraceLog(LOG_WARNING, "Page %d (%s) failed to load", page, sw->pagePaths[page]);
+        MemFree(sw->pagePaths[page]);
+        sw->pagePaths[page] = NULL;
+    }
+    return sw->pages[page].id != 0;
+}
+
+static bool PageMissing(const SwfPack* sw, int page) {
+    return page >= 0 && page < sw->pageCount && !sw->pageArray && !sw->pages[page].id &&
+           sw->pagePaths && sw->pagePaths[page];
+}
+
+// 1re page non chargée du symbole (pageSet, page de chaque frame et de ses tuiles), -1 si tout est là
+static int NextMissingSymbolPage(const SwfPack* sw, int sym, bool firstFrameOnly) {
+    if (sym < 0 || sym >= sw->symbolCount || !sw->pagePaths) return -1;
+    const Symbol* S = &sw->symbols[sym];
+    if (!firstFrameOnly)
+        for (int k = 0; k < S->pageSetCount; ++k) if (PageMissing(sw, S->pageSet[k])) return S->pageSet[k];
+    int frames = firstFrameOnly && S->frameCount > 0 ? 1 : S->frameCount;
+    for (int fi = 0; fi < frames; ++fi) {
+        const Frame* f = &S->frames[fi];
+        if (!f->tiled && PageMissing(sw, f->page)) return f->page;
+        for (int t = 0; t < f->tileCount; ++t) if (PageMissing(sw, f->tiles[t].page)) return f->tiles[t].page;
+    }
+    return -1;
+}
+
+static void EnsureSymbolPages(SwfPack* sw, int sym) {
+    for (int page; (page = NextMissingSymbolPage(sw, sym, false)) >= 0; ) EnsurePageLoaded(sw, page);
+}
+
+// pageSet d'un symbole (sans doublons); S->pageSet alloué pour cap pages
+static void PageSetAdd(Symbol* S, int page) {
+    for (int j = 0; j < S->pageSetCount; ++j) if (S->pageSet[j] == page) return;
+    S->pageSet[S->pageSetCount++] = page;
+}
+
+// "pageSet" absent: pages des frames, celles des tuiles pour une frame en tuiles
+static void DerivePageSet(Symbol* S) {
+    int cap = 0;
+    for (int fi = 0; fi < S->frameCount; ++fi) cap += S->frames[fi].tiled ? S->frames[fi].tileCount : 1;
+    S->pageSet = cap > 0 ? (int*)MemAlloc(sizeof(int) * cap) : NULL;
+    for (int fi = 0; fi < S->frameCount; ++fi) {
+        const Frame* f = &S->frames[fi];
+        if (!f->tiled) PageSetAdd(S, f->page);
+        for (int t = 0; t < f->tileCount; ++t) PageSetAdd(S, f->tiles[t].page);
+    }
+}
+
 // --------------- JSON -> SwfPack --------------
 static SwfPack LoadSwfPackFromJson(const char* jsonPath) {
     SwfPack sw = (SwfPack){0};
@@ -151,16 +755,22 @@ static SwfPack LoadSwfPackFromJson(const char* jsonPath) {
     cJSON* fps = cJSON_GetObjectItem(root, "fps");
     sw.fps = (fps && cJSON_IsNumber(fps)) ? (float)fps->valuedouble : 24.0f;
 
-    // global pages
+    // global pages (pageFormats optionnel, aligné sur pages: chaque page a son propre format)
     cJSON* pages = cJSON_GetObjectItem(root, "pages");
-    if (pages && cJSON_IsArray(pages)) {
+    cJSON* pageFormats = cJSON_GetObjectItem(root, "pageFormats");
+    if (pages && cJSON_IsArray(pages) && cJSON_GetArraySize(pages) > 0) {
         sw.pageCount = cJSON_GetArraySize(pages);
-        sw.pages = (Texture2D*)MemAlloc(sizeof(Texture2D) * sw.pageCount);
+        const char** paths = (const char**)MemAlloc(sizeof(char*) * sw.pageCount);
+        const char** formats = (const char**)MemAlloc(sizeof(char*) * sw.pageCount);
         for (int i = 0; i < sw.pageCount; ++i) {
             cJSON* it = cJSON_GetArrayItem(pages, i);
-            const char* pth = cJSON_IsString(it) ? it->valuestring : NULL;
-            sw.pages[i] = pth ? LoadTextureFromPak(pth) : (Texture2D){0};
+            cJSON* pf = cJSON_IsArray(pageFormats) ? cJSON_GetArrayItem(pageFormats, i) : NULL;
+            paths[i] = cJSON_IsString(it) ? it->valuestring : NULL;
+            formats[i] = cJSON_IsString(pf) ? pf->valuestring : NULL;
         }
+        LoadPackPages(&sw, paths, formats);
+        MemFree((void*)paths);
+        MemFree((void*)formats);
     }
 
     cJSON* symbols = cJSON_GetObjectItem(root, "symbols");
@@ -190,6 +800,7 @@ static SwfPack LoadSwfPackFromJson(const char* jsonPath) {
                     v = cJSON_GetObjectItem(fr, "ox");       if (cJSON_IsNumber(v)) f.ox = (int)v->valuedouble;
                     v = cJSON_GetObjectItem(fr, "oy");       if (cJSON_IsNumber(v)) f.oy = (int)v->valuedouble;
                     v = cJSON_GetObjectItem(fr, "duration"); if (cJSON_IsNumber(v)) f.duration = (int)v->valuedouble; else f.duration = 1;
+                    v = cJSON_GetObjectItem(fr, "rot");      if (cJSON_IsNumber(v)) f.rot = (int)v->valuedouble != 0;
                     cJSON* poly = cJSON_GetObjectItem(fr, "poly");
                     if (poly && cJSON_IsArray(poly)) {
                         int outerCount = cJSON_GetArraySize(poly);
@@ -234,9 +845,38 @@ static SwfPack LoadSwfPackFromJson(const char* jsonPath) {
                         f.polyCount = 0;
                         f.polys = NULL;
                     }
+                    cJSON* tiles = cJSON_GetObjectItem(fr, "tiles");
+                    if (cJSON_IsArray(tiles)) {
+                        // [ [dx, dy, page, x, y, w, h], ... ]
+                        f.tiled = 1;
+                        f.tileCount = cJSON_GetArraySize(tiles);
+                        f.tiles = f.tileCount > 0 ? (Tile*)MemAlloc(sizeof(Tile) * f.tileCount) : NULL;
+                        for (int k = 0; k < f.tileCount; ++k) {
+                            cJSON* t = cJSON_GetArrayItem(tiles, k);
+                            int tv[7] = {0};
+                            for (int c = 0; c < 7; ++c) {
+                                cJSON* n = cJSON_GetArrayItem(t, c);
+                                tv[c] = cJSON_IsNumber(n) ? (int)n->valuedouble : 0;
+                            }
+                            f.tiles[k] = (Tile){ tv[0], tv[1], tv[2], tv[3], tv[4], tv[5], tv[6] };
+                        }
+                    }
                     sw.symbols[si].frames[fi] = f;
                 }
             }
+
+            Symbol* S = &sw.symbols[si];
+            cJSON* pageSet = cJSON_GetObjectItem(sym, "pageSet");
+            if (cJSON_IsArray(pageSet)) {
+                int cap = cJSON_GetArraySize(pageSet);
+                S->pageSet = cap > 0 ? (int*)MemAlloc(sizeof(int) * cap) : NULL;
+                for (int k = 0; k < cap; ++k) {
+                    cJSON* v = cJSON_GetArrayItem(pageSet, k);
+                    if (cJSON_IsNumber(v)) PageSetAdd(S, (int)v->valuedouble);
+                }
+            } else {
+                DerivePageSet(S);
+            }
         }
     }
 
@@ -245,6 +885,289 @@ static SwfPack LoadSwfPackFromJson(const char* jsonPath) {
     return sw;
 }
 
+// --------------- .swfb -> SwfPack --------------
+// Meta binaire écrite par Exporter.as (META=bin) ou swfmeta.py: mêmes données que le JSON,
+// little-endian, chaînes dans une table indexée en u16 (format détaillé dans swfmeta.py).
+#define SWFB_VERSION   1
+#define SWFB_NO_STRING 0xFFFF
+
+typedef struct { const unsigned char* p; const unsigned char* end; bool ok; } BinReader;
+
+static unsigned int RdU8(BinReader* r) {
+    if (r->p + 1 > r->end) { r->ok = false; return 0; }
+    return *r->p++;
+}
+static unsigned int RdU16(BinReader* r) {
+    if (r->p + 2 > r->end) { r->ok = false; return 0; }
+    unsigned int v = (unsigned int)r->p[0] | ((unsigned int)r->p[1] << 8);
+    r->p += 2;
+    return v;
+}
+static int RdI16(BinReader* r) { return (int)(short)RdU16(r); }
+static float RdF32(BinReader* r) {
+    unsigned int u = RdU16(r);
+    u |= RdU16(r) << 16;
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+static const char* SwfbString(char** table, int count, unsigned int i) {
+    return (i != SWFB_NO_STRING && (int)i < count) ? table[i] : NULL;
+}
+
+static SwfPack LoadSwfPackFromBinary(const char* path) {
+    SwfPack sw = (SwfPack){0};
+    int sz = 0;
+    unsigned char* data = ReadAllPhysFS(path, &sz);
+    if (!data) { TraceLog(LOG_ERROR, "Missing swfb: %s", path); return sw; }
+    BinReader r = { data, data + sz, true };
+    if (sz < 22 || memcmp(data, "SWFB", 4) != 0) { TraceLog(LOG_ERROR, "Not a swfb: %s", path); MemFree(data); return sw; }
+    r.p += 4;
+    unsigned int version = RdU16(&r);
+    if (version != SWFB_VERSION) { TraceLog(LOG_ERROR, "swfb version %u unsupported: %s", version, path); MemFree(data); return sw; }
+    RdU16(&r);                                  // flags
+    sw.fps = RdF32(&r);
+    RdF32(&r); RdU16(&r); RdU16(&r); RdU16(&r); // scale, padding, atlasSize: inutiles au rendu
+
+    // table de chaînes: copiées une fois (terminées par 0) dans un seul bloc
+    int strCount = (int)RdU16(&r);
+    char** strs = (char**)MemAlloc(sizeof(char*) * (strCount > 0 ? strCount : 1));
+    char* pool = (char*)MemAlloc((size_t)sz + (size_t)strCount + 1);
+    char* w = pool;
+    for (int i = 0; i < strCount && r.ok; ++i) {
+        unsigned int n = RdU16(&r);
+        if (r.p + n > r.end) { r.ok = false; break; }
+        memcpy(w, r.p, n);
+        w[n] = 0;
+        strs[i] = w;
+        w += n + 1;
+        r.p += n;
+    }
+
+    RdU16(&r);                                  // nom du SWF
+    sw.pageCount = (int)RdU16(&r);
+    if (sw.pageCount > 0) {
+        const char** paths = (const char**)MemAlloc(sizeof(char*) * sw.pageCount);
+        const char** formats = (const char**)MemAlloc(sizeof(char*) * sw.pageCount);
+        for (int i = 0; i < sw.pageCount; ++i) {
+            paths[i] = SwfbString(strs, strCount, RdU16(&r));
+            formats[i] = SwfbString(strs, strCount, RdU16(&r));
+            if (!r.ok) paths[i] = NULL;
+        }
+        LoadPackPages(&sw, paths, formats);
+        MemFree((void*)paths);
+        MemFree((void*)formats);
+    }
+
+    sw.symbolCount = (int)RdU16(&r);
+    sw.symbols = sw.symbolCount > 0 ? (Symbol*)MemAlloc(sizeof(Symbol) * sw.symbolCount) : NULL;
+    if (sw.symbols) memset(sw.symbols, 0, sizeof(Symbol) * sw.symbolCount);
+    for (int si = 0; si < sw.symbolCount && r.ok; ++si) {
+        Symbol* S = &sw.symbols[si];
+        const char* name = SwfbString(strs, strCount, RdU16(&r));
+        S->name = TextDuplicate(name ? name : "symbol");
+        RdU16(&r); RdU16(&r);                   // export, type
+        for (int n = (int)RdU16(&r); n > 0 && r.ok; --n) { RdU16(&r); RdU16(&r); }   // labels
+        for (int n = (int)RdU16(&r); n > 0 && r.ok; --n) { RdU16(&r); RdU16(&r); }   // pages propres (perSymbol)
+
+        int setCount = (int)RdU16(&r);
+        const unsigned char* setData = r.p;
+        for (int k = 0; k < setCount; ++k) RdU16(&r);
+
+        int fc = (int)RdU16(&r);
+        S->frameCount = fc;
+        S->frames = fc > 0 ? (Frame*)MemAlloc(sizeof(Frame) * fc) : NULL;
+        for (int fi = 0; fi < fc && r.ok; ++fi) {
+            Frame f = {0};
+            f.idx = (int)RdU16(&r);
+            f.page = (int)RdU16(&r);
+            f.x = RdI16(&r); f.y = RdI16(&r); f.w = RdI16(&r); f.h = RdI16(&r);
+            f.ox = RdI16(&r); f.oy = RdI16(&r);
+            f.duration = (int)RdU16(&r);
+            unsigned int flags = RdU8(&r);
+            f.rot = (flags & 1) != 0;
+            f.polyCount = (int)RdU8(&r);
+            f.polys = f.polyCount > 0 ? (Poly*)MemAlloc(sizeof(Poly) * f.polyCount) : NULL;
+            for (int pi = 0; pi < f.polyCount; ++pi) {
+                unsigned int head = RdU16(&r);
+                bool wide = (head & 0x8000) != 0;
+                int n = (int)(head & 0x7FFF);
+                f.polys[pi].count = r.ok ? n : 0;
+                f.polys[pi].pts = (r.ok && n > 0) ? (Pt*)MemAlloc(sizeof(Pt) * n) : NULL;
+                for (int k = 0; k < f.polys[pi].count; ++k) {
+                    f.polys[pi].pts[k].x = (float)(wide ? RdI16(&r) : (int)RdU8(&r));
+                    f.polys[pi].pts[k].y = (float)(wide ? RdI16(&r) : (int)RdU8(&r));
+                }
+            }
+            if (flags & 4) {
+                f.tiled = 1;
+                int n = (int)RdU16(&r);
+                f.tileCount = r.ok ? n : 0;
+                f.tiles = f.tileCount > 0 ? (Tile*)MemAlloc(sizeof(Tile) * f.tileCount) : NULL;
+                for (int k = 0; k < f.tileCount; ++k) {
+                    Tile* t = &f.tiles[k];
+                    t->dx = (int)RdU16(&r); t->dy = (int)RdU16(&r); t->page = (int)RdU16(&r);
+                    t->x = (int)RdU16(&r);  t->y = (int)RdU16(&r);
+                    t->w = (int)RdU8(&r);   t->h = (int)RdU8(&r);
+                }
+            }
+            S->frames[fi] = f;
+        }
+
+        // pageSet écrit, sinon déduit des frames et de leurs tuiles (comme pour le JSON)
+        if (setCount > 0) {
+            S->pageSet = (int*)MemAlloc(sizeof(int) * setCount);
+            for (int k = 0; k < setCount && r.ok; ++k) PageSetAdd(S, (int)(setData[2*k] | (setData[2*k + 1] << 8)));
+        } else {
+            DerivePageSet(S);
+        }
+    }
+
+    if (!r.ok) TraceLog(LOG_ERROR, "swfb truncated: %s", path);
+    MemFree(pool);
+    MemFree(strs);
+    MemFree(data);
+    return sw;
+}
+
+// --------------- mode M: maillages serrés --------------
+// Le hull de l'exporteur (computeConvexHullPolygon) est pris au seuil alpha 96 puis rétréci d'1 px:
+// on le dilate (décalage des arêtes) pour retrouver la frange AA, plus l'écart possible entre deux
+// lignes échantillonnées (pas adaptatif = min(w,h)/50), puis on le découpe au rect de la frame.
+#define MESH_EXPAND_PX 2.0f
+
+static float PolySignedArea(const Pt* p, int n) {
+    float a = 0.0f;
+    for (int i = 0; i < n; ++i) a += p[i].x * p[(i + 1) % n].y - p[(i + 1) % n].x * p[i].y;
+    return 0.5f * a;
+}
+static float Cross3(Pt o, Pt a, Pt b) { return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x); }
+static int ComparePt(const void* a, const void* b) {
+    const Pt* p = (const Pt*)a; const Pt* q = (const Pt*)b;
+    if (p->x != q->x) return p->x < q->x ? -1 : 1;
+    return (p->y > q->y) - (p->y < q->y);
+}
+
+// chaîne monotone d'Andrew (comme Exporter.as): pts triés sur place, out >= 2n, retourne le nb de sommets
+static int ConvexHullPts(Pt* pts, int n, Pt* out) {
+    qsort(pts, (size_t)n, sizeof(Pt), ComparePt);
+    int k = 0;
+    for (int i = 0; i < n; ++i) {
+        while (k >= 2 && Cross3(out[k-2], out[k-1], pts[i]) <= 0) k--;
+        out[k++] = pts[i];
+    }
+    for (int i = n - 2, lo = k + 1; i >= 0; --i) {
+        while (k >= lo && Cross3(out[k-2], out[k-1], pts[i]) <= 0) k--;
+        out[k++] = pts[i];
+    }
+    return k > 1 ? k - 1 : k;
+}
+
+// garde le côté où axis*(coord) <= limit (axis: 0 = x, 1 = y; sign = +1 borne haute, -1 borne basse)
+static int ClipPolyAxis(const Pt* in, int n, Pt* out, int axis, float sign, float limit) {
+    int k = 0;
+    for (int i = 0; i < n; ++i) {
+        Pt a = in[i], b = in[(i + 1) % n];
+        float da = sign * (axis ? a.y : a.x) - limit, db = sign * (axis ? b.y : b.x) - limit;
+        if (da <= 0) out[k++] = a;
+        if ((da < 0 && db > 0) || (da > 0 && db < 0)) {
+            float t = da / (da - db);
+            out[k++] = (Pt){ a.x + t * (b.x - a.x), a.y + t * (b.y - a.y) };
+        }
+    }
+    return k;
+}
+
+static void BuildFrameMesh(Frame* f) {
+    f->mesh = NULL;
+    f->meshCount = 0;
+    f->meshArea = (float)(f->w * f->h);
+    int total = 0;
+    for (int pi = 0; pi < f->polyCount; ++pi) total += f->polys[pi].count;
+    if (f->tiled || total < 3 || f->w <= 0 || f->h <= 0) return;
+
+    // une enveloppe pour tous les polygones de la frame
+    Pt* pts = (Pt*)MemAlloc(sizeof(Pt) * total);
+    Pt* a = (Pt*)MemAlloc(sizeof(Pt) * (2 * total + 8));
+    Pt* b = (Pt*)MemAlloc(sizeof(Pt) * (2 * total + 8));
+    for (int pi = 0, k = 0; pi < f->polyCount; ++pi)
+        for (int i = 0; i < f->polys[pi].count; ++i) pts[k++] = f->polys[pi].pts[i];
+    int n = ConvexHullPts(pts, total, a);
+
+    if (n >= 3) {
+        int step = (f->w < f->h ? f->w : f->h) / 50;
+        float d = MESH_EXPAND_PX + (step > 1 ? (float)(step - 1) : 0.0f);
+        float s = PolySignedArea(a, n) > 0.0f ? 1.0f : -1.0f;
+        // sommet i = intersection des arêtes i-1 et i décalées de d vers l'extérieur
+        for (int i = 0; i < n; ++i) {
+            Pt p0 = a[(i + n - 1) % n], p1 = a[i], p2 = a[(i + 1) % n];
+            float l1 = hypotf(p1.x - p0.x, p1.y - p0.y), l2 = hypotf(p2.x - p1.x, p2.y - p1.y);
+            if (l1 < 1e-6f || l2 < 1e-6f) { b[i] = p1; continue; }
+            float n1x = s * (p1.y - p0.y) / l1, n1y = -s * (p1.x - p0.x) / l1;
+            float n2x = s * (p2.y - p1.y) / l2, n2y = -s * (p2.x - p1.x) / l2;
+            float den = 1.0f + n1x * n2x + n1y * n2y;
+            if (den < 1e-3f) b[i] = (Pt){ p1.x + d * n1x, p1.y + d * n1y };
+            else             b[i] = (Pt){ p1.x + d * (n1x + n2x) / den, p1.y + d * (n1y + n2y) / den };
+        }
+        n = ClipPolyAxis(b, n, a, 0, -1.0f, 0.0f);
+        n = ClipPolyAxis(a, n, b, 0,  1.0f, (float)f->w);
+        n = ClipPolyAxis(b, n, a, 1, -1.0f, 0.0f);
+        n = ClipPolyAxis(a, n, b, 1,  1.0f, (float)f->h);
+    }
+    if (n >= 3) {
+        // même sens que les quads de rlgl (sinon éliminé par le back-face culling)
+        if (PolySignedArea(b, n) > 0.0f)
+            for (int i = 0; i < n / 2; ++i) { Pt t = b[i]; b[i] = b[n - 1 - i]; b[n - 1 - i] = t; }
+        f->mesh = (Pt*)MemAlloc(sizeof(Pt) * n);
+        memcpy(f->mesh, b, sizeof(Pt) * n);
+        f->meshCount = n;
+        f->meshArea = fabsf(PolySignedArea(b, n));
+    }
+    MemFree(pts);
+    MemFree(a);
+    MemFree(b);
+}
+
+static void BuildPackMeshes(SwfPack* sw) {
+    int frames = 0, meshed = 0, verts = 0;
+    double quadPx = 0.0, meshPx = 0.0;
+    for (int s = 0; s < sw->symbolCount; ++s) {
+        for (int i = 0; i < sw->symbols[s].frameCount; ++i) {
+            Frame* f = &sw->symbols[s].frames[i];
+            BuildFrameMesh(f);
+            if (f->tiled) continue;
+            frames++;
+            quadPx += (double)f->w * f->h;
+            meshPx += f->meshArea;
+            if (f->mesh) { meshed++; verts += f->meshCount; }
+        }
+    }
+    if (frames > 0)
+        TraceLog(LOG_INFO, "Meshes: %d/%d frames, %.1f verts avg, %.0f%% of quad fill",
+                 meshed, frames, meshed ? (float)verts / meshed : 0.0f, quadPx > 0 ? 100.0 * meshPx / quadPx : 100.0);
+}
+
+// <swf>.json (indenté ou minifié) ou <swf>.swfb selon l'extension
+// métadonnées seules (pages à la demande, pas de tableau L ni de maillages): index des symboles
+static SwfPack LoadSwfPackMeta(const char* path) {
+    const char* dot = strrchr(path, '.');
+    return (dot && strcasecmp(dot, ".swfb") == 0) ? LoadSwfPackFromBinary(path) : LoadSwfPackFromJson(path);
+}
+
+// tout sauf GL (utilisable par le thread de préchargement): métadonnées + maillages
+static SwfPack LoadSwfPackCpu(const char* path) {
+    SwfPack sw = LoadSwfPackMeta(path);
+    BuildPackMeshes(&sw);
+    return sw;
+}
+
+static SwfPack LoadSwfPack(const char* path) {
+    SwfPack sw = LoadSwfPackCpu(path);
+    if (gPageArrays) PackUsePageArray(&sw);
+    return sw;
+}
+
 static void UnloadSwfPack(SwfPack* sw) {
     if (sw->symbols) {
         for (int s=0;s<sw->symbolCount;s++) {
@@ -255,20 +1178,754 @@ static void UnloadSwfPack(SwfPack* sw) {
                             if (sw->symbols[s].frames[f].polys[pi].pts) MemFree(sw->symbols[s].frames[f].polys[pi].pts);
                         MemFree(sw->symbols[s].frames[f].polys);
                     }
+                    if (sw->symbols[s].frames[f].tiles) MemFree(sw->symbols[s].frames[f].tiles);
+                    if (sw->symbols[s].frames[f].mesh) MemFree(sw->symbols[s].frames[f].mesh);
                 }
                 MemFree(sw->symbols[s].frames);
             }
             if (sw->symbols[s].name) MemFree((void*)sw->symbols[s].name);
+            if (sw->symbols[s].pageSet) MemFree(sw->symbols[s].pageSet);
         }
         MemFree(sw->symbols);
     }
     if (sw->pages) {
-        for (int i=0;i<sw->pageCount;i++) if (sw->pages[i].id) UnloadTexture(sw->pages[i]);
+        for (int i=0;i<sw->pageCount;i++) if (sw->pages[i].id) ReleasePageTexture(sw->pages[i]);   // + sa palette
         MemFree(sw->pages);
     }
+    if (sw->palettes) MemFree(sw->palettes);
+    if (sw->pagePaths) {
+        for (int i=0;i<sw->pageCount;i++) {
+            if (sw->pagePaths[i]) MemFree(sw->pagePaths[i]);
+            if (sw->pageFormats[i]) MemFree(sw->pageFormats[i]);
+        }
+        MemFree(sw->pagePaths);
+        MemFree(sw->pageFormats);
+    }
+    if (sw->pageArray) glDeleteTextures(1, &sw->pageArray);
     *sw = (SwfPack){0};
 }
 
+// --------------- cache de packs (LRU) --------------
+// Les packs quittés restent chargés (CPU + pages GPU) tant que le total résident tient dans
+// PACKCACHE_BUDGET_MB; revenir sur un pack récent ne recharge rien. Les pages sont comptées une
+// fois même si plusieurs packs résidents les partagent (registre SharedPage).
+#ifndef PACKCACHE_BUDGET_MB
+    #define PACKCACHE_BUDGET_MB 512
+#endif
+
+typedef struct {
+    char* path;           // jsonPath du pack
+    SwfPack pack;
+    long long cpuBytes;
+    unsigned int lastUse;
+    int inUse;            // > 0: pack affiché, jamais évincé
+    bool prefetched;      // chargé par le préchargement, pas encore affiché (métadonnées seules)
+} PackCacheEntry;
+
+static PackCacheEntry* gPackCache = NULL;
+static int gPackCacheCount = 0;
+static unsigned int gPackCacheClock = 0;
+static int gPackCacheHits = 0, gPackCacheMisses = 0;
+static int gPackCachePrefetchHits = 0;   // 1er affichage d'un pack préchargé (ni hit ni miss)
+
+static long long PackCpuBytes(const SwfPack* sw) {
+    long long bytes = sizeof(SwfPack) + (long long)sw->pageCount * 2 * sizeof(Texture2D) + (long long)sw->symbolCount * sizeof(Symbol);
+    for (int i = 0; sw->pagePaths && i < sw->pageCount; ++i)
+        bytes += 2 * sizeof(char*) + (sw->pagePaths[i] ? strlen(sw->pagePaths[i]) + 1 : 0) + (sw->pageFormats[i] ? strlen(sw->pageFormats[i]) + 1 : 0);
+    for (int s = 0; s < sw->symbolCount; ++s) {
+        const Symbol* S = &sw->symbols[s];
+        bytes += (S->name ? strlen(S->name) + 1 : 0) + (long long)S->pageSetCount * sizeof(int) + (long long)S->frameCount * sizeof(Frame);
+        for (int f = 0; f < S->frameCount; ++f) {
+            const Frame* F = &S->frames[f];
+            bytes += (long long)F->polyCount * sizeof(Poly) + (long long)F->tileCount * sizeof(Tile) + (long long)F->meshCount * sizeof(Pt);
+            for (int pi = 0; pi < F->polyCount; ++pi) bytes += (long long)F->polys[pi].count * sizeof(Pt);
+        }
+    }
+    return bytes;
+}
+
+// CPU des packs résidents + pages GPU uniques (registre) + tableaux de pages (propres à chaque pack)
+static long long PackCacheResidentBytes(void) {
+    long long bytes = 0;
+    for (int i = 0; i < gPackCacheCount; ++i) {
+        bytes += gPackCache[i].cpuBytes;
+        if (gPackCache[i].pack.pageArray) bytes += TextureBytes(gPackCache[i].pack.pages[0]) * gPackCache[i].pack.pageCount;
+    }
+    for (int i = 0; i < gSharedPageCount; ++i)
+        bytes += TextureBytes(gSharedPages[i].tex) + (gSharedPages[i].palette.id ? 256 * 4 : 0);
+    return bytes;
+}
+
+static void PackCacheTrim(void) {
+    long long budget = (long long)PACKCACHE_BUDGET_MB * 1024 * 1024;
+    while (PackCacheResidentBytes() > budget) {
+        int lru = -1;
+        for (int i = 0; i < gPackCacheCount; ++i)
+            if (!gPackCache[i].inUse && (lru < 0 || gPackCache[i].lastUse < gPackCache[lru].lastUse)) lru = i;
+        if (lru < 0) break;   // seul le pack affiché reste, même hors budget
+        TraceLog(LOG_INFO, "PackCache: evict %s", gPackCache[lru].path);
+        UnloadSwfPack(&gPackCache[lru].pack);
+        MemFree(gPackCache[lru].path);
+        gPackCache[lru] = gPackCache[--gPackCacheCount];
+    }
+}
+
+static void PackCacheInsert(const char* path, SwfPack sw, int inUse, bool prefetched) {
+    gPackCache = (PackCacheEntry*)MemRealloc(gPackCache, sizeof(PackCacheEntry) * (gPackCacheCount + 1));
+    gPackCache[gPackCacheCount++] = (PackCacheEntry){ TextDuplicate(path), sw, PackCpuBytes(&sw), ++gPackCacheClock, inUse, prefetched };
+    PackCacheTrim();
+}
+
+// pack prêt à afficher: résident (hit, instantané) ou chargé puis mis en cache (miss)
+static SwfPack AcquirePack(const char* path) {
+    for (int i = 0; i < gPackCacheCount; ++i) {
+        PackCacheEntry* e = &gPackCache[i];
+        if (strcmp(e->path, path) != 0) continue;
+        if (e->prefetched) {
+            // préchargé en métadonnées seules: le tableau de pages (mode L) se construit maintenant
+            gPackCachePrefetchHits++;
+            e->prefetched = false;
+            if (gPageArrays && PackUsePageArray(&e->pack)) e->cpuBytes = PackCpuBytes(&e->pack);
+        } else {
+            gPackCacheHits++;
+        }
+        e->inUse++;
+        e->lastUse = ++gPackCacheClock;
+        return e->pack;
+    }
+    gPackCacheMisses++;
+    SwfPack sw = LoadSwfPack(path);
+    if (sw.symbolCount == 0 && sw.pageCount == 0) return sw;   // échec de chargement: rien à garder
+    PackCacheInsert(path, sw, 1, false);
+    return sw;
+}
+
+// le pack n'est plus affiché: il reste résident jusqu'à éviction
+static void ReleasePack(SwfPack* sw) {
+    for (int i = 0; i < gPackCacheCount; ++i) {
+        PackCacheEntry* e = &gPackCache[i];
+        if (e->pack.symbols == sw->symbols && e->pack.pages == sw->pages && e->inUse > 0) {
+            e->inUse--;
+            e->lastUse = ++gPackCacheClock;
+            *sw = (SwfPack){0};
+            PackCacheTrim();
+            return;
+        }
+    }
+    UnloadSwfPack(sw);   // pas en cache (pack vide)
+}
+
+// vide le cache (mode de chargement des pages changé, sortie); les packs encore affichés sont libérés aussi
+static void PackCacheClear(void) {
+    for (int i = 0; i < gPackCacheCount; ++i) {
+        UnloadSwfPack(&gPackCache[i].pack);
+        MemFree(gPackCache[i].path);
+    }
+    if (gPackCache) MemFree(gPackCache);
+    gPackCache = NULL;
+    gPackCacheCount = 0;
+}
+
+static int PackCacheFind(const char* path) {
+    for (int i = 0; i < gPackCacheCount; ++i) if (strcmp(gPackCache[i].path, path) == 0) return i;
+    return -1;
+}
+
+// --------------- préchargement des voisins --------------
+// Les artistes avancent pack par pack / symbole par symbole: après une sélection, on réchauffe les
+// symboles i±1 (toutes leurs pages) puis les packs i±1 (métadonnées + pages de la 1re frame du 1er
+// symbole). Lecture et décodage (métadonnées, pages) sur un thread ouvrier, une demande à la fois;
+// le thread principal ne fait que l'upload GL du résultat, au plus un par frame, après
+// PREFETCH_DELAY_FRAMES frames sans changement de sélection. Un pack voisin n'est chargé qu'en
+// métadonnées, même en mode L: son tableau de pages n'est construit qu'à son affichage (AcquirePack).
+// Une nouvelle sélection annule la file (et le résultat en cours); arrêt à PREFETCH_BUDGET_MB
+// préchargés ou dès que le cache de packs est plein (le préchargement ne doit jamais évincer ce
+// qu'on affiche). Les chargements du préchargement ne comptent pas dans les hits/misses du cache.
+#define PREFETCH_DELAY_FRAMES 10
+#define PREFETCH_BUDGET_MB    128
+
+typedef struct {
+    char* packPath;
+    int symbol;
+    bool firstFrameOnly;  // pack voisin: seulement la 1re frame
+    bool acquired;        // métadonnées déjà demandées (échec ou éviction => job abandonné)
+} PrefetchJob;
+
+// demande au thread ouvrier et son résultat
+typedef struct {
+    unsigned int gen;     // gPrefetchGen à la demande: résultat ignoré si la sélection a changé
+    char* packPath;
+    int page;             // -1: métadonnées du pack, sinon page à décoder
+    char* path;
+    char* format;
+    SwfPack pack;         // résultat: pack sans GL (LoadSwfPackCpu)
+    Image img;            // résultat: page DDS/PNG décodée
+    unsigned char* raw;   // résultat: page PAL8 lue (découpée à l'upload)
+    int rawSize;
+} PrefetchWork;
+
+static PrefetchJob* gPrefetchJobs = NULL;
+static int gPrefetchCount = 0, gPrefetchHead = 0;
+static int gPrefetchIdle = 0;
+static long long gPrefetchBytes = 0;
+static int gPrefetchSteps = 0;
+static unsigned int gPrefetchGen = 0;
+
+static PrefetchWork gPrefetchWork;
+static int gPrefetchState = 0;   // 0 libre, 1 demande en cours, 2 résultat prêt
+static bool gPrefetchQuit = false;
+static SyncLock gPrefetchLock = SYNC_LOCK_INIT;
+static SyncCond gPrefetchWake = SYNC_COND_INIT;
+static WorkerThread gPrefetchThread;
+static bool gPrefetchThreadOn = false;
+
+THREAD_PROC(PrefetchWorker) {
+    (void)arg;
+    SyncLockAcquire(&gPrefetchLock);
+    for (;;) {
+        while (!gPrefetchQuit && gPrefetchState != 1) SyncCondWait(&gPrefetchWake, &gPrefetchLock);
+        if (gPrefetchQuit) break;
+        PrefetchWork w = gPrefetchWork;
+        SyncLockRelease(&gPrefetchLock);
+        if (w.page < 0) w.pack = LoadSwfPackCpu(w.packPath);
+        else if (w.format && strcmp(w.format, "PAL8") == 0) w.raw = ReadAllPhysFS(w.path, &w.rawSize);
+        else w.img = LoadPageImageFromPak(w.path, w.format);
+        SyncLockAcquire(&gPrefetchLock);
+        gPrefetchWork = w;
+        gPrefetchState = 2;
+    }
+    SyncLockRelease(&gPrefetchLock);
+    return 0;
+}
+
+static void PrefetchWorkFree(PrefetchWork* w) {
+    if (w->pack.symbols || w->pack.pages) UnloadSwfPack(&w->pack);   // jamais affiché: aucune texture
+    if (w->img.data) UnloadImage(w->img);
+    if (w->raw) MemFree(w->raw);
+    if (w->packPath) MemFree(w->packPath);
+    if (w->path) MemFree(w->path);
+    if (w->format) MemFree(w->format);
+    *w = (PrefetchWork){0};
+}
+
+static void PrefetchStart(void) {
+    gPrefetchThreadOn = ThreadStart(&gPrefetchThread, PrefetchWorker);
+    if (!gPrefetchThreadOn) TraceLog(LOG_WARNING, "Prefetch: worker thread not started, prefetch disabled");
+}
+
+// attend la fin de la demande en cours (au plus un décodage) avant de libérer ce qu'elle lit
+static void PrefetchStop(void) {
+    if (!gPrefetchThreadOn) return;
+    SyncLockAcquire(&gPrefetchLock);
+    gPrefetchQuit = true;
+    SyncCondSignal(&gPrefetchWake);
+    SyncLockRelease(&gPrefetchLock);
+    ThreadJoin(gPrefetchThread);
+    gPrefetchThreadOn = false;
+    if (gPrefetchState != 0) PrefetchWorkFree(&gPrefetchWork);
+    gPrefetchState = 0;
+}
+
+static void PrefetchCancel(void) {
+    for (int i = 0; i < gPrefetchCount; ++i) MemFree(gPrefetchJobs[i].packPath);
+    if (gPrefetchJobs) MemFree(gPrefetchJobs);
+    gPrefetchJobs = NULL;
+    gPrefetchCount = gPrefetchHead = 0;
+    gPrefetchGen++;
+}
+
+static void PrefetchPush(const char* packPath, int symbol, bool firstFrameOnly) {
+    if (!packPath || symbol < 0) return;
+    gPrefetchJobs = (PrefetchJob*)MemRealloc(gPrefetchJobs, sizeof(PrefetchJob) * (gPrefetchCount + 1));
+    gPrefetchJobs[gPrefetchCount++] = (PrefetchJob){ TextDuplicate(packPath), symbol, firstFrameOnly, false };
+}
+
+// sélection courante (pack packPath affiché dans sw, symbole sym) -> nouvelle file, l'ancienne est annulée
+static void PrefetchSchedule(const char* packPath, const SwfPack* sw, int sym, const char* prevPack, const char* nextPack) {
+    PrefetchCancel();
+    gPrefetchIdle = 0;
+    gPrefetchBytes = 0;
+    if (sym + 1 < sw->symbolCount) PrefetchPush(packPath, sym + 1, false);
+    if (sym - 1 >= 0)              PrefetchPush(packPath, sym - 1, false);
+    PrefetchPush(nextPack, 0, true);
+    if (prevPack != nextPack) PrefetchPush(prevPack, 0, true);
+}
+
+static void PrefetchPost(const char* packPath, int page, const char* path, const char* format) {
+    SyncLockAcquire(&gPrefetchLock);
+    gPrefetchWork = (PrefetchWork){ gPrefetchGen, TextDuplicate(packPath), page, TextDuplicate(path), TextDuplicate(format) };
+    gPrefetchState = 1;
+    SyncCondSignal(&gPrefetchWake);
+    SyncLockRelease(&gPrefetchLock);
+}
+
+// page décodée par le thread ouvrier -> texture partagée (upload seulement; déjà chargée => simple référence)
+static void PrefetchUploadPage(SwfPack* sw, int page, PrefetchWork* w) {
+    char key[600];
+    PageTextureKey(sw->pagePaths[page], sw->pageFormats[page], key, sizeof(key));
+    Texture2D tex = {0}, palette = {0};
+    if (!SharedPageTake(key, &tex, &palette)) {
+        if (w->raw) {
+            tex = LoadPalettePageFromData(w->path, w->raw, w->rawSize, &palette);
+            w->raw = NULL;   // libéré par LoadPalettePageFromData
+        } else if (w->img.data) {
+            tex = UploadPageImage(w->path, w->format, w->img);
+        }
+        if (tex.id) SharedPageAdd(key, tex, palette);
+    }
+    if (!tex.id) {
+        TraceLog(LOG_WARNING, "Page %d (%s) failed to load", page, sw->pagePaths[page]);
+        MemFree(sw->pagePaths[page]);
+        sw->pagePaths[page] = NULL;
+        return;
+    }
+    sw->pages[page] = tex;       // pages[] partagé avec les copies affichées
+    sw->palettes[page] = palette;
+}
+
+// résultat du thread ouvrier -> cache de packs (métadonnées) ou page du pack résident
+static void PrefetchCollect(void) {
+    SyncLockAcquire(&gPrefetchLock);
+    bool ready = gPrefetchState == 2;
+    PrefetchWork w = gPrefetchWork;
+    if (ready) gPrefetchState = 0;
+    SyncLockRelease(&gPrefetchLock);
+    if (!ready) return;
+    if (w.gen == gPrefetchGen) {
+        long long before = PackCacheResidentBytes();
+        int e = PackCacheFind(w.packPath);
+        if (w.page < 0) {
+            if (e < 0 && (w.pack.symbolCount > 0 || w.pack.pageCount > 0)) {
+                PackCacheInsert(w.packPath, w.pack, 0, true);
+                w.pack = (SwfPack){0};
+            }
+        } else if (e >= 0 && PageMissing(&gPackCache[e].pack, w.page)) {
+            PrefetchUploadPage(&gPackCache[e].pack, w.page, &w);
+            PackCacheTrim();
+        }
+        long long grown = PackCacheResidentBytes() - before;
+        if (grown > 0) gPrefetchBytes += grown;
+        gPrefetchSteps++;
+    }
+    PrefetchWorkFree(&w);
+}
+
+static void PrefetchStep(void) {
+    PrefetchCollect();
+    if (gPrefetchIdle < PREFETCH_DELAY_FRAMES) { gPrefetchIdle++; return; }
+    if (!gPrefetchThreadOn) return;
+    SyncLockAcquire(&gPrefetchLock);
+    bool busy = gPrefetchState != 0;
+    SyncLockRelease(&gPrefetchLock);
+    if (busy) return;
+    while (gPrefetchHead < gPrefetchCount) {
+        if (gPrefetchBytes >= (long long)PREFETCH_BUDGET_MB * 1024 * 1024 ||
+            PackCacheResidentBytes() >= (long long)PACKCACHE_BUDGET_MB * 1024 * 1024) {
+            TraceLog(LOG_INFO, "Prefetch: budget reached, %d jobs dropped", gPrefetchCount - gPrefetchHead);
+            PrefetchCancel();
+            return;
+        }
+        PrefetchJob* j = &gPrefetchJobs[gPrefetchHead];
+        int e = PackCacheFind(j->packPath);
+        if (e < 0) {
+            if (j->acquired) { gPrefetchHead++; continue; }
+            j->acquired = true;
+            PrefetchPost(j->packPath, -1, NULL, NULL);   // métadonnées seules, pages à la demande
+            return;
+        }
+        SwfPack* sw = &gPackCache[e].pack;
+        int page = NextMissingSymbolPage(sw, j->symbol, j->firstFrameOnly);
+        if (page < 0) { gPrefetchHead++; continue; }
+        PrefetchPost(j->packPath, page, sw->pagePaths[page], sw->pageFormats[page]);
+        return;
+    }
+}
+
+// Passe de comptage (mode F): chaque fragment rastérisé ajoute 1/255 en R, et 1/255 en G si le texel
+// est entièrement transparent (fill-rate payé pour rien). Même ligne dans tous les shaders de page.
+#define COUNT_GLSL \
+    "    if (countMode == 1) finalColor = vec4(1.0/255.0, c.a < 1.0/255.0 ? 1.0/255.0 : 0.0, 0.0, 1.0);\n"
+
+// --------------- pages PAL8: recherche de palette dans le shader --------------
+// Bilinéaire manuel: les 4 index voisins sont lus sans filtrage (texelFetch), convertis en
+// couleurs de palette, puis interpolés; interpoler les index eux-mêmes mélangerait des entrées sans rapport.
+static const char* PALETTE_FS =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"   // index (R8)
+    "uniform sampler2D palette;\n"    // 256x1 RGBA
+    "uniform vec4 colDiffuse;\n"
+    "uniform int countMode;\n"
+    "out vec4 finalColor;\n"
+    "vec4 lookup(ivec2 p, ivec2 size) {\n"
+    "    int i = int(texelFetch(texture0, clamp(p, ivec2(0), size - 1), 0).r * 255.0 + 0.5);\n"
+    "    return texelFetch(palette, ivec2(i, 0), 0);\n"
+    "}\n"
+    "void main() {\n"
+    "    ivec2 size = textureSize(texture0, 0);\n"
+    "    vec2 p = fragTexCoord * vec2(size) - 0.5;\n"
+    "    ivec2 b = ivec2(floor(p));\n"
+    "    vec2 f = p - floor(p);\n"
+    "    vec4 c = mix(mix(lookup(b, size), lookup(b + ivec2(1, 0), size), f.x),\n"
+    "                 mix(lookup(b + ivec2(0, 1), size), lookup(b + ivec2(1, 1), size), f.x), f.y);\n"
+    "    finalColor = c * colDiffuse * fragColor;\n"
+    COUNT_GLSL
+    "}\n";
+
+// pages ordinaires pendant la passe de comptage
+static const char* COUNT_FS =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "uniform sampler2D texture0;\n"
+    "out vec4 finalColor;\n"
+    "const int countMode = 1;\n"
+    "void main() {\n"
+    "    vec4 c = texture(texture0, fragTexCoord);\n"
+    COUNT_GLSL
+    "}\n";
+
+static Shader gPaletteShader = {0};
+static int gPaletteLoc = -1, gPaletteCountLoc = -1;
+static Shader gCountShader = {0};
+
+static void InitPaletteShader(void) {
+    gPaletteShader = LoadShaderFromMemory(NULL, PALETTE_FS);
+    gPaletteLoc = GetShaderLocation(gPaletteShader, "palette");
+    gPaletteCountLoc = GetShaderLocation(gPaletteShader, "countMode");
+    gCountShader = LoadShaderFromMemory(NULL, COUNT_FS);
+}
+
+// encadre le dessin d'une page: shader palette si la page est PAL8, shader de comptage
+// pendant la passe F, rien sinon
+static bool BeginPageDraw(const SwfPack* sw, int page) {
+    if (!sw->palettes || page < 0 || page >= sw->pageCount || !sw->palettes[page].id) {
+        if (!gCountPass) return false;
+        BeginShaderMode(gCountShader);
+        return true;
+    }
+    int count = gCountPass ? 1 : 0;
+    BeginShaderMode(gPaletteShader);
+    SetShaderValueTexture(gPaletteShader, gPaletteLoc, sw->palettes[page]);
+    SetShaderValue(gPaletteShader, gPaletteCountLoc, &count, SHADER_UNIFORM_INT);
+    return true;
+}
+static void EndPageDraw(bool paletted) {
+    if (paletted) EndShaderMode();
+}
+
+// --------------- mode L: toutes les pages dans un GL_TEXTURE_2D_ARRAY --------------
+// Le lot de rlgl n'a pas d'attribut libre: la couche voyage dans la partie entière de u
+// (u' = u + 2*couche, u dans [0,1]); le shader la sépare avant d'échantillonner.
+// Le tableau est lié sur une unité à part, hors de celles que rlgl gère pour ses lots.
+#define PAGE_ARRAY_UNIT 7
+static const char* PAGE_ARRAY_FS =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2DArray pages;\n"
+    "uniform vec4 colDiffuse;\n"
+    "uniform int countMode;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    float layer = floor(fragTexCoord.x * 0.5);\n"
+    "    vec2 uv = vec2(fragTexCoord.x - 2.0 * layer, fragTexCoord.y);\n"
+    "    vec4 c = texture(pages, vec3(uv, layer));\n"
+    "    finalColor = c * colDiffuse * fragColor;\n"
+    COUNT_GLSL
+    "}\n";
+
+static Shader gPageArrayShader = {0};
+static int gPageArrayLoc = -1, gPageArrayCountLoc = -1;
+
+static void InitPageArrays(void) {
+    pglTexImage3D = (PfnTexImage3D)glfwGetProcAddress("glTexImage3D");
+    pglCompressedTexImage3D = (PfnCompressedTexImage3D)glfwGetProcAddress("glCompressedTexImage3D");
+    pglActiveTexture = (PfnActiveTexture)glfwGetProcAddress("glActiveTexture");
+    if (!pglTexImage3D || !pglCompressedTexImage3D || !pglActiveTexture)
+        TraceLog(LOG_WARNING, "Page array: GL 3 entry points missing, mode L disabled");
+    gPageArrayShader = LoadShaderFromMemory(NULL, PAGE_ARRAY_FS);
+    gPageArrayLoc = GetShaderLocation(gPageArrayShader, "pages");
+    gPageArrayCountLoc = GetShaderLocation(gPageArrayShader, "countMode");
+}
+
+// l'appelant émet ses quads (rlBegin/rlEnd) entre Begin et End: toutes les pages dans le même lot
+static void BeginPageArrayDraw(const SwfPack* sw) {
+    BeginShaderMode(gPageArrayShader);     // vide le lot précédent
+    int unit = PAGE_ARRAY_UNIT, count = gCountPass ? 1 : 0;
+    SetShaderValue(gPageArrayShader, gPageArrayLoc, &unit, SHADER_UNIFORM_INT);
+    SetShaderValue(gPageArrayShader, gPageArrayCountLoc, &count, SHADER_UNIFORM_INT);
+    pglActiveTexture(GL_TEXTURE0 + PAGE_ARRAY_UNIT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, sw->pageArray);
+    pglActiveTexture(GL_TEXTURE0);
+    rlSetTexture(rlGetTextureIdDefault());  // texture0 inutilisée, mais un id est requis par le lot
+}
+static void EndPageArrayDraw(void) {
+    rlSetTexture(0);
+    EndShaderMode();                       // dessine le lot tant que le tableau est lié
+    pglActiveTexture(GL_TEXTURE0 + PAGE_ARRAY_UNIT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    pglActiveTexture(GL_TEXTURE0);
+}
+
+// src: rect dans la page (stockée h x w si rot), dst: rect écran de la frame redressée
+static void PageArrayQuad(const SwfPack* sw, int layer, Rectangle src, Rectangle dst, bool rot) {
+    float W = (float)sw->pages[0].width, H = (float)sw->pages[0].height;
+    float u0 = 2.0f * layer + src.x / W, u1 = 2.0f * layer + (src.x + src.width) / W;
+    float v0 = src.y / H, v1 = (src.y + src.height) / H;
+    float x0 = dst.x, y0 = dst.y, x1 = dst.x + dst.width, y1 = dst.y + dst.height;
+    if (rot) {
+        // rotation horaire au stockage: le coin haut-gauche de la frame est le coin haut-droit stocké
+        rlTexCoord2f(u1, v0); rlVertex2f(x0, y0);
+        rlTexCoord2f(u0, v0); rlVertex2f(x0, y1);
+        rlTexCoord2f(u0, v1); rlVertex2f(x1, y1);
+        rlTexCoord2f(u1, v1); rlVertex2f(x1, y0);
+    } else {
+        rlTexCoord2f(u0, v0); rlVertex2f(x0, y0);
+        rlTexCoord2f(u0, v1); rlVertex2f(x0, y1);
+        rlTexCoord2f(u1, v1); rlVertex2f(x1, y1);
+        rlTexCoord2f(u1, v0); rlVertex2f(x1, y0);
+    }
+}
+
+// frame pleine (tournée ou non) dans le lot du tableau
+static void DrawFramePageArray(const SwfPack* sw, const Frame* f, Rectangle dst, Color tint) {
+    Rectangle src = f->rot ? (Rectangle){ (float)f->x, (float)f->y, (float)f->h, (float)f->w }
+                           : (Rectangle){ (float)f->x, (float)f->y, (float)f->w, (float)f->h };
+    BeginPageArrayDraw(sw);
+    rlCheckRenderBatchLimit(4);
+    rlBegin(RL_QUADS);
+    rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    PageArrayQuad(sw, f->page, src, dst, f->rot != 0);
+    rlEnd();
+    EndPageArrayDraw();
+}
+
+// p: sommet du maillage en coords frame redressée; u/v lus dans la rect stockée (h x w si rot)
+static void MeshVertex(const Frame* f, Pt p, Rectangle dst, float W, float H, float uOffset) {
+    float u = f->rot ? (f->x + f->h - p.y) / W : (f->x + p.x) / W;
+    float v = f->rot ? (f->y + p.x) / H : (f->y + p.y) / H;
+    rlTexCoord2f(uOffset + u, v);
+    rlVertex2f(dst.x + p.x * dst.width / f->w, dst.y + p.y * dst.height / f->h);
+}
+
+// frame pleine en éventail de triangles sur son maillage: seuls les px du hull sont rastérisés
+static void DrawFrameMesh(const SwfPack* sw, const Frame* f, Rectangle dst, Color tint) {
+    Texture2D tex = sw->pages[f->page];
+    bool paletted = false;
+    if (sw->pageArray) BeginPageArrayDraw(sw);
+    else {
+        if (!tex.id) return;
+        paletted = BeginPageDraw(sw, f->page);
+        rlSetTexture(tex.id);
+    }
+    float uOffset = sw->pageArray ? 2.0f * f->page : 0.0f;
+    rlCheckRenderBatchLimit(3 * (f->meshCount - 2));
+    rlBegin(RL_TRIANGLES);
+    rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    for (int i = 1; i + 1 < f->meshCount; ++i) {
+        MeshVertex(f, f->mesh[0], dst, (float)tex.width, (float)tex.height, uOffset);
+        MeshVertex(f, f->mesh[i], dst, (float)tex.width, (float)tex.height, uOffset);
+        MeshVertex(f, f->mesh[i + 1], dst, (float)tex.width, (float)tex.height, uOffset);
+    }
+    rlEnd();
+    if (sw->pageArray) EndPageArrayDraw();
+    else {
+        rlSetTexture(0);
+        EndPageDraw(paletted);
+    }
+}
+
+// Frame en tuiles: un lot de quads (RL_QUADS) par page, les tuiles étant triées par page.
+// Découpé par paquets pour ne jamais dépasser le batch par défaut de rlgl.
+#define TILE_QUADS_PER_BATCH 1024
+static void DrawFrameTiles(const SwfPack* sw, const Frame* f, float x, float y, float scale, Color tint) {
+    if (sw->pageArray) {
+        // mode L: toutes les tuiles, toutes pages confondues, dans le même lot
+        BeginPageArrayDraw(sw);
+        for (int i = 0; i < f->tileCount; i += TILE_QUADS_PER_BATCH) {
+            int end = i + TILE_QUADS_PER_BATCH < f->tileCount ? i + TILE_QUADS_PER_BATCH : f->tileCount;
+            rlCheckRenderBatchLimit(4 * (end - i));
+            rlBegin(RL_QUADS);
+            rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+            rlNormal3f(0.0f, 0.0f, 1.0f);
+            for (int k = i; k < end; ++k) {
+                const Tile* t = &f->tiles[k];
+                if (t->page < 0 || t->page >= sw->pageCount) continue;
+                Rectangle src = { (float)t->x, (float)t->y, (float)t->w, (float)t->h };
+                Rectangle dst = { x + t->dx * scale, y + t->dy * scale, t->w * scale, t->h * scale };
+                PageArrayQuad(sw, t->page, src, dst, false);
+            }
+            rlEnd();
+        }
+        EndPageArrayDraw();
+        return;
+    }
+    for (int i = 0; i < f->tileCount; ) {
+        int page = f->tiles[i].page;
+        int end = i;
+        while (end < f->tileCount && f->tiles[end].page == page && end - i < TILE_QUADS_PER_BATCH) end++;
+        Texture2D tex = (page >= 0 && page < sw->pageCount) ? sw->pages[page] : (Texture2D){0};
+        if (tex.id) {
+            bool paletted = BeginPageDraw(sw, page);
+            rlCheckRenderBatchLimit(4 * (end - i));
+            rlSetTexture(tex.id);
+            rlBegin(RL_QUADS);
+            rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+            rlNormal3f(0.0f, 0.0f, 1.0f);
+            for (int k = i; k < end; ++k) {
+                const Tile* t = &f->tiles[k];
+                float u0 = (float)t->x / tex.width,          v0 = (float)t->y / tex.height;
+                float u1 = (float)(t->x + t->w) / tex.width, v1 = (float)(t->y + t->h) / tex.height;
+                float x0 = x + t->dx * scale, y0 = y + t->dy * scale;
+                float x1 = x0 + t->w * scale, y1 = y0 + t->h * scale;
+                rlTexCoord2f(u0, v0); rlVertex2f(x0, y0);
+                rlTexCoord2f(u0, v1); rlVertex2f(x0, y1);
+                rlTexCoord2f(u1, v1); rlVertex2f(x1, y1);
+                rlTexCoord2f(u1, v0); rlVertex2f(x1, y0);
+            }
+            rlEnd();
+            rlSetTexture(0);
+            EndPageDraw(paletted);
+        }
+        i = end;
+    }
+}
+
+// dessine une frame selon son mode (tuiles, maillage M, tableau L, quad) -> px rastérisés
+static float DrawFrameAt(const SwfPack* sw, const Frame* f, Rectangle dst, float scale) {
+    if (f->tiled) {
+        float px = 0.0f;
+        for (int k = 0; k < f->tileCount; ++k) px += f->tiles[k].w * f->tiles[k].h * scale * scale;
+        DrawFrameTiles(sw, f, dst.x, dst.y, scale, WHITE);
+        return px;
+    }
+    if (gMeshes && f->mesh) {
+        DrawFrameMesh(sw, f, dst, WHITE);
+        return f->meshArea * scale * scale;
+    }
+    if (sw->pageArray) {
+        DrawFramePageArray(sw, f, dst, WHITE);
+    } else {
+        Texture2D tex = sw->pages[f->page];
+        bool paletted = BeginPageDraw(sw, f->page);
+        if (f->rot) {
+            // rect stockée h x w : on la redresse de -90° autour du coin bas-gauche de dst
+            Rectangle srcRot = { (float)f->x, (float)f->y, (float)f->h, (float)f->w };
+            Rectangle dstRot = { dst.x, dst.y + dst.height, dst.height, dst.width };
+            DrawTexturePro(tex, srcRot, dstRot, (Vector2){0,0}, -90.0f, WHITE);
+        } else {
+            Rectangle src = { (float)f->x, (float)f->y, (float)f->w, (float)f->h };
+            DrawTexturePro(tex, src, dst, (Vector2){0,0}, 0.0f, WHITE);
+        }
+        EndPageDraw(paletted);
+    }
+    return dst.width * dst.height;
+}
+
+// --------------- mode F: carte d'overdraw --------------
+// La scène est redessinée dans une cible RGBA8 en blending additif avec les shaders de comptage
+// (cf. COUNT_GLSL): R = couches par pixel, G = couches dont le texel était transparent.
+// La cible est relue toutes les OVERDRAW_READBACK_FRAMES images pour les stats, puis affichée en heatmap.
+#define OVERDRAW_READBACK_FRAMES 10
+static const char* HEATMAP_FS =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "uniform sampler2D texture0;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    vec4 t = texture(texture0, fragTexCoord);\n"
+    "    float n = floor(t.r * 255.0 + 0.5), clear = floor(t.g * 255.0 + 0.5);\n"
+    "    if (n < 0.5) discard;\n"
+    // 1 couche bleu, 2 vert, 3 jaune, 4+ rouge; gris si toutes les couches sont transparentes
+    "    vec3 c = n < 1.5 ? vec3(0.1, 0.3, 1.0) : n < 2.5 ? vec3(0.1, 0.9, 0.2)\n"
+    "           : n < 3.5 ? vec3(1.0, 0.9, 0.1) : vec3(1.0, 0.15, 0.1);\n"
+    "    if (clear >= n) c = vec3(0.45);\n"
+    "    finalColor = vec4(c, 0.75);\n"
+    "}\n";
+
+typedef struct {
+    long long pixels;     // px touchés au moins une fois
+    long long layers;     // fragments rastérisés
+    long long clear;      // fragments sur texel entièrement transparent
+    int maxLayers;
+} OverdrawStats;
+
+static Shader gHeatmapShader = {0};
+static RenderTexture2D gCountTarget = {0};
+static OverdrawStats gOverdraw = {0};
+
+static void InitOverdraw(void) {
+    gHeatmapShader = LoadShaderFromMemory(NULL, HEATMAP_FS);
+}
+
+static void BeginOverdrawCount(void) {
+    int w = GetScreenWidth(), h = GetScreenHeight();
+    if (gCountTarget.id == 0 || gCountTarget.texture.width != w || gCountTarget.texture.height != h) {
+        if (gCountTarget.id) UnloadRenderTexture(gCountTarget);
+        gCountTarget = LoadRenderTexture(w, h);
+    }
+    BeginTextureMode(gCountTarget);
+    ClearBackground(BLANK);
+    BeginBlendMode(BLEND_ADDITIVE);
+    gCountPass = true;
+}
+
+static void EndOverdrawCount(void) {
+    gCountPass = false;
+    EndBlendMode();
+    EndTextureMode();
+
+    static int sinceReadback = OVERDRAW_READBACK_FRAMES;
+    if (++sinceReadback >= OVERDRAW_READBACK_FRAMES) {
+        sinceReadback = 0;
+        Image img = LoadImageFromTexture(gCountTarget.texture);
+        OverdrawStats st = {0};
+        const unsigned char* px = (const unsigned char*)img.data;
+        for (int i = 0, n = img.width * img.height; px && i < n; ++i) {
+            int layers = px[i * 4], clear = px[i * 4 + 1];
+            if (!layers) continue;
+            st.pixels++;
+            st.layers += layers;
+            st.clear += clear;
+            if (layers > st.maxLayers) st.maxLayers = layers;
+        }
+        UnloadImage(img);
+        gOverdraw = st;
+    }
+
+    // heatmap à la place de la scène (cible rendue à l'envers: hauteur négative)
+    BeginShaderMode(gHeatmapShader);
+    DrawTextureRec(gCountTarget.texture, (Rectangle){ 0, 0, (float)gCountTarget.texture.width, -(float)gCountTarget.texture.height },
+                   (Vector2){ 0, 0 }, WHITE);
+    EndShaderMode();
+}
+
+static void UnloadOverdraw(void) {
+    if (gCountTarget.id) UnloadRenderTexture(gCountTarget);
+    UnloadShader(gHeatmapShader);
+}
+
+// VRAM estimée d'un pack (mips comprises) + répartition par format de page
+static void DescribePackPages(const SwfPack* sw, char* out, int outSize) {
+    long long bytes = 0;
+    int bc1 = 0, bc3 = 0, pal = 0, other = 0, resident = 0;
+    for (int i = 0; i < sw->pageCount; ++i) {
+        Texture2D t = sw->pages[i];
+        if (!t.id && !sw->pageArray) continue;
+        resident++;
+        bytes += TextureBytes(t);
+        if (sw->palettes && sw->palettes[i].id) { pal++; bytes += 256 * 4; }
+        else if (t.format == PIXELFORMAT_COMPRESSED_DXT1_RGB || t.format == PIXELFORMAT_COMPRESSED_DXT1_RGBA) bc1++;
+        else if (t.format == PIXELFORMAT_COMPRESSED_DXT5_RGBA) bc3++;
+        else other++;
+    }
+    snprintf(out, outSize, "pages=%d, %d loaded (BC1 %d, BC3 %d, PAL8 %d, other %d)  VRAM=%.2f MB  %s",
+             sw->pageCount, resident, bc1, bc3, pal, other, bytes / (1024.0 * 1024.0), sw->pageArray ? "array (L)" : "per-page (L)");
+}
+
 // -------- mount all *.pak in working directory --------
 static void MountAllPaksInCwd(void) {
     // List only *.pak files in the current working directory
@@ -312,11 +1969,11 @@ static PackList FindRootJsonPacks(void) {
     PackList L = {0};
     char **list = PHYSFS_enumerateFiles("/");
     for (char **i = list; *i; i++) {
-        const char* name = *i;                   // ex: "431.json"
+        const char* name = *i;                   // ex: "431.json" ou "431.swfb"
         char full[512]; snprintf(full, sizeof(full), "%s", name); // racine => path = name
         if (!PHYSFS_isDirectory(full)) {
             const char* dot = strrchr(name, '.');
-            if (dot && (strcasecmp(dot, ".json") == 0)) {
+            if (dot && (strcasecmp(dot, ".json") == 0 || strcasecmp(dot, ".swfb") == 0)) {
                 PushPack(&L, name, full);        // display = "431.json", path = "431.json"
             }
         }
@@ -382,6 +2039,262 @@ static void FreeSwfList(SwfList* L) {
     *L = (SwfList){0};
 }
 
+// --------------- index global des symboles --------------
+// Trouver le pack d'un symbole sans ouvrir les packs un par un: au montage, nom de symbole (interné)
+// -> (pack, n° de symbole, frames, pageSet) pour tous les packs. Persisté dans SYMINDEX_FILE à côté
+// des paks; les packs d'un pak dont la taille et la date n'ont pas bougé reprennent leurs entrées,
+// seuls ceux des paks nouveaux ou modifiés sont relus (métadonnées seules).
+// packs[i] de l'index == packs.arr[i] de la PackList qui l'a construit.
+#define SYMINDEX_FILE    ".symbol_index"
+#define SYMINDEX_MAGIC   0x49535753u   // "SWSI"
+#define SYMINDEX_VERSION 1u
+#define SYMINDEX_RESULTS 12
+
+typedef struct { unsigned int magic, version; int pakCount, packCount, nameCount, entryCount, pageSetTotal, blobSize; } SymIndexHeader;
+typedef struct { int file, pad; long long size, mtime; } SymIndexPak;     // file: nom du .pak (offset dans blob)
+typedef struct { int path, pak, first, count; } SymIndexPack;            // entries[first..first+count), pak -1 = hors pak
+typedef struct { int name, pack, symbol, frameCount, pageSet, pageSetCount; } SymIndexEntry;   // name: index dans names[]
+
+typedef struct {
+    SymIndexPak* paks;      int pakCount, pakCap;
+    SymIndexPack* packs;    int packCount, packCap;
+    int* names;             int nameCount, nameCap;      // noms uniques (offsets dans blob)
+    SymIndexEntry* entries; int entryCount, entryCap;
+    int* pageSets;          int pageSetTotal, pageSetCap;
+    char* blob;             int blobSize, blobCap;       // toutes les chaînes, terminées par 0
+    // reconstruits en mémoire, pas persistés
+    int* hash;              int hashCap;                 // intern: nom -> index + 1 (adressage ouvert)
+    int* nameFirst;         // 1re entrée de chaque nom, suivantes par nameNext
+    int* nameNext;
+    char* lower;            // blob en minuscules (recherche insensible à la casse)
+} SymbolIndex;
+
+static SymbolIndex gSymIndex = {0};
+
+static void* GrowArray(void* p, int* cap, int need, int elemSize) {
+    if (need <= *cap) return p;
+    int c = *cap ? *cap : 64;
+    while (c < need) c *= 2;
+    *cap = c;
+    return MemRealloc(p, (unsigned int)((size_t)c * elemSize));
+}
+
+static unsigned int HashStr(const char* s) {
+    unsigned int h = 2166136261u;   // FNV-1a
+    while (*s) h = (h ^ (unsigned char)*s++) * 16777619u;
+    return h;
+}
+
+static void SymIndexFree(SymbolIndex* x) {
+    void* arrays[] = { x->paks, x->packs, x->names, x->entries, x->pageSets, x->blob, x->hash, x->nameFirst, x->nameNext, x->lower };
+    for (int i = 0; i < (int)(sizeof(arrays) / sizeof(arrays[0])); ++i) if (arrays[i]) MemFree(arrays[i]);
+    *x = (SymbolIndex){0};
+}
+
+static int SymIndexAddString(SymbolIndex* x, const char* s) {
+    int n = (int)strlen(s) + 1;
+    x->blob = (char*)GrowArray(x->blob, &x->blobCap, x->blobSize + n, 1);
+    memcpy(x->blob + x->blobSize, s, (size_t)n);
+    x->blobSize += n;
+    return x->blobSize - n;
+}
+
+static void SymIndexRehash(SymbolIndex* x) {
+    if (x->hash) MemFree(x->hash);
+    x->hashCap = 64;
+    while (x->hashCap < x->nameCount * 2 + 2) x->hashCap *= 2;
+    x->hash = (int*)MemAlloc(sizeof(int) * x->hashCap);
+    memset(x->hash, 0, sizeof(int) * x->hashCap);
+    for (int i = 0; i < x->nameCount; ++i) {
+        unsigned int h = HashStr(x->blob + x->names[i]) & (x->hashCap - 1);
+        while (x->hash[h]) h = (h + 1) & (x->hashCap - 1);
+        x->hash[h] = i + 1;
+    }
+}
+
+static int SymIndexInternName(SymbolIndex* x, const char* s) {
+    if ((x->nameCount + 1) * 2 > x->hashCap) SymIndexRehash(x);
+    unsigned int h = HashStr(s) & (x->hashCap - 1);
+    for (; x->hash[h]; h = (h + 1) & (x->hashCap - 1))
+        if (strcmp(x->blob + x->names[x->hash[h] - 1], s) == 0) return x->hash[h] - 1;
+    x->names = (int*)GrowArray(x->names, &x->nameCap, x->nameCount + 1, sizeof(int));
+    x->names[x->nameCount] = SymIndexAddString(x, s);
+    x->hash[h] = ++x->nameCount;
+    return x->nameCount - 1;
+}
+
+static void SymIndexAddEntry(SymbolIndex* x, const char* name, int pack, int symbol, int frameCount, const int* pageSet, int pageSetCount) {
+    int nameId = SymIndexInternName(x, name ? name : "");
+    x->pageSets = (int*)GrowArray(x->pageSets, &x->pageSetCap, x->pageSetTotal + pageSetCount, sizeof(int));
+    if (pageSetCount > 0) memcpy(x->pageSets + x->pageSetTotal, pageSet, sizeof(int) * pageSetCount);
+    x->entries = (SymIndexEntry*)GrowArray(x->entries, &x->entryCap, x->entryCount + 1, sizeof(SymIndexEntry));
+    x->entries[x->entryCount++] = (SymIndexEntry){ nameId, pack, symbol, frameCount, x->pageSetTotal, pageSetCount };
+    x->pageSetTotal += pageSetCount;
+}
+
+static bool WriteArray(FILE* fp, const void* p, size_t elemSize, int n) { return n == 0 || fwrite(p, elemSize, (size_t)n, fp) == (size_t)n; }
+static bool ReadArray(FILE* fp, void** p, size_t elemSize, int n) {
+    if (elemSize * (size_t)n > (1u << 30)) return false;   // en-tête corrompu
+    *p = MemAlloc((unsigned int)(elemSize * (n > 0 ? n : 1)));
+    return *p && (n == 0 || fread(*p, elemSize, (size_t)n, fp) == (size_t)n);
+}
+
+static void SymIndexSave(const SymbolIndex* x) {
+    SymIndexHeader h = { SYMINDEX_MAGIC, SYMINDEX_VERSION, x->pakCount, x->packCount, x->nameCount, x->entryCount, x->pageSetTotal, x->blobSize };
+    const char* tmpPath = SYMINDEX_FILE ".part";
+    FILE* fp = fopen(tmpPath, "wb");
+    if (!fp) { TraceLog(LOG_WARNING, "SymbolIndex: cannot write %s", tmpPath); return; }
+    bool ok = fwrite(&h, sizeof(h), 1, fp) == 1
+              && WriteArray(fp, x->paks, sizeof(SymIndexPak), x->pakCount)
+              && WriteArray(fp, x->packs, sizeof(SymIndexPack), x->packCount)
+              && WriteArray(fp, x->names, sizeof(int), x->nameCount)
+              && WriteArray(fp, x->entries, sizeof(SymIndexEntry), x->entryCount)
+              && WriteArray(fp, x->pageSets, sizeof(int), x->pageSetTotal)
+              && WriteArray(fp, x->blob, 1, x->blobSize);
+    ok = (fclose(fp) == 0) && ok;
+    remove(SYMINDEX_FILE);
+    if (!ok || rename(tmpPath, SYMINDEX_FILE) != 0) remove(tmpPath);
+}
+
+// index persisté, vérifié (bornes, chaînes terminées); false => à reconstruire entièrement
+static bool SymIndexLoad(SymbolIndex* x) {
+    *x = (SymbolIndex){0};
+    FILE* fp = fopen(SYMINDEX_FILE, "rb");
+    if (!fp) return false;
+    SymIndexHeader h;
+    bool ok = fread(&h, sizeof(h), 1, fp) == 1 && h.magic == SYMINDEX_MAGIC && h.version == SYMINDEX_VERSION
+              && h.pakCount >= 0 && h.packCount >= 0 && h.nameCount >= 0 && h.entryCount >= 0 && h.pageSetTotal >= 0 && h.blobSize > 0;
+    ok = ok && ReadArray(fp, (void**)&x->paks, sizeof(SymIndexPak), h.pakCount)
+            && ReadArray(fp, (void**)&x->packs, sizeof(SymIndexPack), h.packCount)
+            && ReadArray(fp, (void**)&x->names, sizeof(int), h.nameCount)
+            && ReadArray(fp, (void**)&x->entries, sizeof(SymIndexEntry), h.entryCount)
+            && ReadArray(fp, (void**)&x->pageSets, sizeof(int), h.pageSetTotal)
+            && ReadArray(fp, (void**)&x->blob, 1, h.blobSize);
+    fclose(fp);
+    if (ok) {
+        x->pakCount = x->pakCap = h.pakCount;         x->packCount = x->packCap = h.packCount;
+        x->nameCount = x->nameCap = h.nameCount;      x->entryCount = x->entryCap = h.entryCount;
+        x->pageSetTotal = x->pageSetCap = h.pageSetTotal; x->blobSize = x->blobCap = h.blobSize;
+        ok = x->blob[x->blobSize - 1] == 0;
+        for (int i = 0; ok && i < x->pakCount; ++i) ok = x->paks[i].file >= 0 && x->paks[i].file < x->blobSize;
+        for (int i = 0; ok && i < x->packCount; ++i) {
+            const SymIndexPack* p = &x->packs[i];
+            ok = p->path >= 0 && p->path < x->blobSize && p->pak >= -1 && p->pak < x->pakCount
+                 && p->first >= 0 && p->count >= 0 && p->first + p->count <= x->entryCount;
+        }
+        for (int i = 0; ok && i < x->nameCount; ++i) ok = x->names[i] >= 0 && x->names[i] < x->blobSize;
+        for (int i = 0; ok && i < x->entryCount; ++i) {
+            const SymIndexEntry* e = &x->entries[i];
+            ok = e->name >= 0 && e->name < x->nameCount && e->pack >= 0 && e->pack < x->packCount
+                 && e->pageSet >= 0 && e->pageSetCount >= 0 && e->pageSet + e->pageSetCount <= x->pageSetTotal;
+        }
+    }
+    if (!ok) {
+        SymIndexFree(x);
+        TraceLog(LOG_WARNING, "SymbolIndex: %s unreadable, full rebuild", SYMINDEX_FILE);
+    }
+    return ok;
+}
+
+static int SymIndexFindPak(const SymbolIndex* x, const char* file) {
+    for (int i = 0; i < x->pakCount; ++i) if (strcmp(x->blob + x->paks[i].file, file) == 0) return i;
+    return -1;
+}
+
+// chaînes de noms + blob en minuscules, après construction
+static void SymIndexFinish(SymbolIndex* x) {
+    x->nameFirst = (int*)MemAlloc(sizeof(int) * (x->nameCount > 0 ? x->nameCount : 1));
+    x->nameNext = (int*)MemAlloc(sizeof(int) * (x->entryCount > 0 ? x->entryCount : 1));
+    for (int i = 0; i < x->nameCount; ++i) x->nameFirst[i] = -1;
+    for (int e = x->entryCount - 1; e >= 0; --e) {
+        x->nameNext[e] = x->nameFirst[x->entries[e].name];
+        x->nameFirst[x->entries[e].name] = e;
+    }
+    x->lower = (char*)MemAlloc(x->blobSize > 0 ? x->blobSize : 1);
+    for (int i = 0; i < x->blobSize; ++i) x->lower[i] = (char)tolower((unsigned char)x->blob[i]);
+}
+
+static void BuildSymbolIndex(const PackList* packs) {
+    double t0 = GetTime();
+    SymbolIndex old;
+    bool haveOld = SymIndexLoad(&old);
+    SymbolIndex* x = &gSymIndex;
+    SymIndexFree(x);
+
+    FilePathList list = LoadDirectoryFilesEx(GetWorkingDirectory(), ".pak", false);
+    x->paks = (SymIndexPak*)MemAlloc(sizeof(SymIndexPak) * (list.count > 0 ? list.count : 1));
+    x->pakCap = (int)list.count;
+    int* oldPakOf = (int*)MemAlloc(sizeof(int) * (list.count > 0 ? list.count : 1));
+    for (unsigned int i = 0; i < list.count; ++i) {
+        SymIndexPak pk = { SymIndexAddString(x, GetFileName(list.paths[i])), 0, GetFileLength(list.paths[i]), GetFileModTime(list.paths[i]) };
+        x->paks[x->pakCount] = pk;
+        int op = haveOld ? SymIndexFindPak(&old, x->blob + pk.file) : -1;
+        oldPakOf[x->pakCount++] = (op >= 0 && old.paks[op].size == pk.size && old.paks[op].mtime == pk.mtime) ? op : -1;
+    }
+    UnloadDirectoryFiles(list);
+
+    int scanned = 0, reused = 0;
+    for (int p = 0; p < packs->count; ++p) {
+        const char* path = packs->arr[p].jsonPath;
+        const char* real = PHYSFS_getRealDir(path);
+        int pak = real ? SymIndexFindPak(x, GetFileName(real)) : -1;
+        SymIndexPack pack = { SymIndexAddString(x, path), pak, x->entryCount, 0 };
+        int op = -1;
+        if (pak >= 0 && oldPakOf[pak] >= 0) {
+            // même liste d'une session à l'autre en général: essai à la même position avant la recherche
+            for (int j = -1; j < old.packCount && op < 0; ++j) {
+                int k = j < 0 ? p : j;
+                if (k < old.packCount && old.packs[k].pak == oldPakOf[pak] && strcmp(old.blob + old.packs[k].path, path) == 0) op = k;
+            }
+        }
+        if (op >= 0) {
+            for (int e = old.packs[op].first; e < old.packs[op].first + old.packs[op].count; ++e) {
+                const SymIndexEntry* oe = &old.entries[e];
+                SymIndexAddEntry(x, old.blob + old.names[oe->name], p, oe->symbol, oe->frameCount, old.pageSets + oe->pageSet, oe->pageSetCount);
+            }
+            reused++;
+        } else {
+            SwfPack sw = LoadSwfPackMeta(path);
+            for (int s = 0; s < sw.symbolCount; ++s) {
+                const Symbol* S = &sw.symbols[s];
+                SymIndexAddEntry(x, S->name, p, s, S->frameCount, S->pageSet, S->pageSetCount);
+            }
+            UnloadSwfPack(&sw);
+            scanned++;
+        }
+        pack.count = x->entryCount - pack.first;
+        x->packs = (SymIndexPack*)GrowArray(x->packs, &x->packCap, x->packCount + 1, sizeof(SymIndexPack));
+        x->packs[x->packCount++] = pack;
+    }
+
+    bool changed = scanned > 0 || !haveOld || old.pakCount != x->pakCount || old.packCount != x->packCount;
+    MemFree(oldPakOf);
+    SymIndexFree(&old);
+    SymIndexFinish(x);
+    if (changed) SymIndexSave(x);
+    TraceLog(LOG_INFO, "SymbolIndex: %d symbols (%d names) in %d packs, %d rescanned, %d reused, %.1f ms%s",
+             x->entryCount, x->nameCount, x->packCount, scanned, reused, 1000.0 * (GetTime() - t0), changed ? ", saved" : "");
+}
+
+// entrées dont le nom contient query (casse ignorée): préfixes d'abord, puis le reste -> nombre écrit dans out
+static int SymIndexSearch(const char* query, int* out, int maxOut) {
+    const SymbolIndex* x = &gSymIndex;
+    char q[64];
+    int len = 0;
+    for (; query[len] && len < (int)sizeof(q) - 1; ++len) q[len] = (char)tolower((unsigned char)query[len]);
+    q[len] = 0;
+    if (len == 0 || !x->lower) return 0;
+    int n = 0;
+    for (int pass = 0; pass < 2 && n < maxOut; ++pass) {
+        for (int i = 0; i < x->nameCount && n < maxOut; ++i) {
+            const char* name = x->lower + x->names[i];
+            const char* hit = strstr(name, q);
+            if (!hit || (pass == 0) != (hit == name)) continue;
+            for (int e = x->nameFirst[i]; e >= 0 && n < maxOut; e = x->nameNext[e]) out[n++] = e;
+        }
+    }
+    return n;
+}
 
 static bool PointInPoly(const Vector2 p, const Poly* poly, float offx, float offy, float scale) {
     bool inside = false;
@@ -397,6 +2310,162 @@ static bool PointInPoly(const Vector2 p, const Poly* poly, float offx, float off
     return inside;
 }
 
+// --------------- listes filtrables (packs, symboles) --------------
+// Remplace GuiDropdownBox: la chaîne "a;b;c" était refaite par strcat (O(n²)) et chaque entrée mise
+// en page à chaque frame. Ici: noms en minuscules précalculés une fois, filtre sous-chaîne
+// incrémental (un filtre qui prolonge le précédent ne repasse que sur ses résultats) et seules les
+// lignes visibles sont dessinées. Clic sur l'en-tête: ouvre la liste, frappe directe dans le filtre,
+// haut/bas + Entrée ou clic pour choisir, clic hors de la liste pour fermer (Échap quitte raylib).
+#define BROWSER_ROWS  16
+#define BROWSER_ROW_H 20
+
+typedef struct {
+    const char** names;     // libellés (non possédés)
+    int count;
+    char* lower;            // noms en minuscules, bout à bout
+    int* offsets;
+    int* matches;           // indices retenus par le filtre, ordre d'origine
+    int matchCount;
+    char filter[64], lastFilter[64];
+    bool open, filterEdit;
+    int scroll, cursor;     // 1re ligne visible, ligne surlignée (dans matches)
+} ListBrowser;
+
+static void BrowserFree(ListBrowser* b) {
+    if (b->names) MemFree((void*)b->names);
+    if (b->lower) MemFree(b->lower);
+    if (b->offsets) MemFree(b->offsets);
+    if (b->matches) MemFree(b->matches);
+    *b = (ListBrowser){0};
+}
+
+static void BrowserRefilter(ListBrowser* b) {
+    char q[64];
+    int len = 0;
+    for (; b->filter[len] && len < (int)sizeof(q) - 1; ++len) q[len] = (char)tolower((unsigned char)b->filter[len]);
+    q[len] = 0;
+    // filtre prolongé => sous-ensemble des résultats courants, sinon repart de toute la liste
+    bool narrow = b->lastFilter[0] && strstr(b->filter, b->lastFilter) != NULL;
+    int n = narrow ? b->matchCount : b->count, kept = 0;
+    for (int k = 0; k < n; ++k) {
+        int i = narrow ? b->matches[k] : k;
+        if (len == 0 || strstr(b->lower + b->offsets[i], q)) b->matches[kept++] = i;
+    }
+    b->matchCount = kept;
+    b->scroll = b->cursor = 0;
+    snprintf(b->lastFilter, sizeof(b->lastFilter), "%s", b->filter);
+}
+
+// names: tableau alloué par l'appelant, repris par le browser (libéré par BrowserFree)
+static void BrowserInit(ListBrowser* b, const char** names, int count) {
+    BrowserFree(b);
+    b->names = names;
+    b->count = count;
+    size_t total = 1;
+    for (int i = 0; i < count; ++i) total += strlen(names[i] ? names[i] : "") + 1;
+    b->lower = (char*)MemAlloc((unsigned int)total);
+    b->offsets = (int*)MemAlloc(sizeof(int) * (count > 0 ? count : 1));
+    b->matches = (int*)MemAlloc(sizeof(int) * (count > 0 ? count : 1));
+    size_t o = 0;
+    for (int i = 0; i < count; ++i) {
+        b->offsets[i] = (int)o;
+        for (const char* c = names[i] ? names[i] : ""; *c; ++c) b->lower[o++] = (char)tolower((unsigned char)*c);
+        b->lower[o++] = 0;
+    }
+    BrowserRefilter(b);
+}
+
+static void BrowserHeader(ListBrowser* b, Rectangle r, int active) {
+    char label[160];
+    const char* name = (active >= 0 && active < b->count && b->names[active]) ? b->names[active] : "-";
+    snprintf(label, sizeof(label), "%s   (%d/%d)", name, active + 1, b->count);
+    if (GuiButton(r, label) && b->count > 0) {
+        b->open = true;
+        b->filterEdit = true;
+        // curseur sur l'entrée courante si le filtre la garde: haut/bas repartent de là
+        for (int k = 0; k < b->matchCount; ++k) if (b->matches[k] == active) { b->cursor = k; break; }
+        b->scroll = b->cursor > BROWSER_ROWS / 2 ? b->cursor - BROWSER_ROWS / 2 : 0;
+    }
+}
+
+static void BrowserScrollTo(ListBrowser* b, int row) {
+    if (row < b->scroll) b->scroll = row;
+    if (row >= b->scroll + BROWSER_ROWS) b->scroll = row - BROWSER_ROWS + 1;
+}
+
+// liste ouverte sous l'en-tête r; true si *active a changé
+static bool BrowserPanel(ListBrowser* b, Rectangle r, int* active) {
+    if (!b->open) return false;
+    Rectangle panel = { r.x, r.y + r.height, r.width, 28 + BROWSER_ROWS * BROWSER_ROW_H + 4 };
+    Rectangle list = { panel.x + 2, panel.y + 28, panel.width - 12, BROWSER_ROWS * BROWSER_ROW_H };
+    Vector2 m = GetMousePosition();
+    bool changed = false;
+
+    DrawRectangleRec(panel, GetColor(GuiGetStyle(DEFAULT, BACKGROUND_COLOR)));
+    DrawRectangleLinesEx(panel, 1, GetColor(GuiGetStyle(DEFAULT, LINE_COLOR)));
+    if (GuiTextBox((Rectangle){ panel.x + 2, panel.y + 2, panel.width - 4, 24 }, b->filter, sizeof(b->filter), b->filterEdit))
+        b->filterEdit = !b->filterEdit;
+    if (strcmp(b->filter, b->lastFilter) != 0) BrowserRefilter(b);
+
+    // clavier et molette
+    int maxScroll = b->matchCount > BROWSER_ROWS ? b->matchCount - BROWSER_ROWS : 0;
+    if (IsKeyPressed(KEY_DOWN) || IsKeyPressedRepeat(KEY_DOWN)) { if (b->cursor < b->matchCount - 1) b->cursor++; BrowserScrollTo(b, b->cursor); }
+    if (IsKeyPressed(KEY_UP) || IsKeyPressedRepeat(KEY_UP))     { if (b->cursor > 0) b->cursor--; BrowserScrollTo(b, b->cursor); }
+    if (IsKeyPressed(KEY_PAGE_DOWN)) { b->cursor = b->cursor + BROWSER_ROWS < b->matchCount ? b->cursor + BROWSER_ROWS : b->matchCount - 1; BrowserScrollTo(b, b->cursor); }
+    if (IsKeyPressed(KEY_PAGE_UP))   { b->cursor = b->cursor > BROWSER_ROWS ? b->cursor - BROWSER_ROWS : 0; BrowserScrollTo(b, b->cursor); }
+    if (CheckCollisionPointRec(m, panel)) b->scroll -= (int)(GetMouseWheelMove() * 3);
+    if (b->scroll > maxScroll) b->scroll = maxScroll;
+    if (b->scroll < 0) b->scroll = 0;
+    if (IsKeyPressed(KEY_ENTER) && b->matchCount > 0 && b->cursor >= 0) {
+        changed = *active != b->matches[b->cursor];
+        *active = b->matches[b->cursor];
+        b->open = false;
+    }
+
+    // lignes visibles seulement
+    BeginScissorMode((int)list.x, (int)list.y, (int)list.width, (int)list.height);
+    for (int row = b->scroll; row < b->matchCount && row < b->scroll + BROWSER_ROWS; ++row) {
+        int i = b->matches[row];
+        Rectangle rr = { list.x, list.y + (row - b->scroll) * BROWSER_ROW_H, list.width, BROWSER_ROW_H };
+        bool hover = CheckCollisionPointRec(m, rr);
+        int base = i == *active ? BASE_COLOR_PRESSED : (hover || row == b->cursor) ? BASE_COLOR_FOCUSED : BASE_COLOR_NORMAL;
+        DrawRectangleRec(rr, GetColor(GuiGetStyle(DEFAULT, base)));
+        DrawText(b->names[i] ? b->names[i] : "", (int)rr.x + 6, (int)rr.y + 4, 12, GetColor(GuiGetStyle(DEFAULT, TEXT_COLOR_NORMAL)));
+        if (hover && b->open && IsMouseButtonReleased(MOUSE_BUTTON_LEFT)) {
+            changed = *active != i;
+            *active = i;
+            b->open = false;
+        }
+    }
+    EndScissorMode();
+
+    // ascenseur: hauteur du pouce = part visible, clic/glisser dans la piste pour sauter
+    Rectangle track = { list.x + list.width + 2, list.y, 6, list.height };
+    DrawRectangleRec(track, GetColor(GuiGetStyle(DEFAULT, BASE_COLOR_NORMAL)));
+    if (b->matchCount > BROWSER_ROWS) {
+        float h = track.height * BROWSER_ROWS / b->matchCount;
+        if (h < 8) h = 8;
+        DrawRectangleRec((Rectangle){ track.x, track.y + (track.height - h) * b->scroll / maxScroll, track.width, h },
+                         GetColor(GuiGetStyle(DEFAULT, BORDER_COLOR_FOCUSED)));
+        if (IsMouseButtonDown(MOUSE_BUTTON_LEFT) && CheckCollisionPointRec(m, (Rectangle){ track.x - 4, track.y, track.width + 8, track.height }))
+            b->scroll = (int)((m.y - track.y) / track.height * maxScroll + 0.5f);
+    }
+    char count[64];
+    snprintf(count, sizeof(count), "%d / %d", b->matchCount, b->count);
+    DrawText(count, (int)(panel.x + panel.width - MeasureText(count, 10) - 8), (int)(panel.y + 9), 10, GetColor(GuiGetStyle(DEFAULT, TEXT_COLOR_DISABLED)));
+
+    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && !CheckCollisionPointRec(m, panel)) b->open = false;
+    if (!b->open) b->filterEdit = false;
+    return changed;
+}
+
+// noms des symboles d'un pack pour son browser (pointeurs dans le pack: à refaire après chaque AcquirePack)
+static void BrowserSetSymbols(ListBrowser* b, const SwfPack* sw) {
+    const char** names = (const char**)MemAlloc(sizeof(char*) * (sw->symbolCount > 0 ? sw->symbolCount : 1));
+    for (int i = 0; i < sw->symbolCount; ++i) names[i] = sw->symbols[i].name;
+    BrowserInit(b, names, sw->symbolCount);
+}
+
 // ----------------------- main --------------------------
 int main(void) {
     // PhysFS init
@@ -409,44 +2478,38 @@ int main(void) {
     // Trouve tous les JSON à la racine des .pak montés
     PackList packs = FindRootJsonPacks();  // -> packs.arr[i].displayName / .jsonPath
     if (packs.count == 0) {
-        TraceLog(LOG_FATAL, "Aucun pack SWF trouvé (attendu: *.json à la racine) dans les .pak montés");
+        TraceLog(LOG_FATAL, "Aucun pack SWF trouvé (attendu: *.json ou *.swfb à la racine) dans les .pak montés");
         PHYSFS_deinit();
         return 1;
     }
 
-    // Construit la liste pour le dropdown raygui (séparée par ';')
-    size_t total = 1;
-    for (int i = 0; i < packs.count; ++i) total += strlen(packs.arr[i].displayName) + 1;
-    char* ddPacks = (char*)MemAlloc(total);
-    ddPacks[0] = 0;
-    for (int i = 0; i < packs.count; ++i) {
-        strcat(ddPacks, packs.arr[i].displayName);
-        if (i < packs.count - 1) strcat(ddPacks, ";");
+    // Listes filtrables des packs et des symboles du pack courant
+    ListBrowser packBrowser = {0}, symBrowser = {0};
+    {
+        const char** names = (const char**)MemAlloc(sizeof(char*) * packs.count);
+        for (int i = 0; i < packs.count; ++i) names[i] = packs.arr[i].displayName;
+        BrowserInit(&packBrowser, names, packs.count);
     }
 
     // Raylib
     SetConfigFlags(FLAG_WINDOW_HIGHDPI);
-    InitWindow(1280, 720, "Raylib + PhysFS + DDS + 2 dropdowns");
+    InitWindow(1280, 720, "Raylib + PhysFS + DDS + pack browser");
     SetTargetFPS(60);
+    InitPaletteShader();
+    InitPageArrays();
+    InitOverdraw();
+    EnsureDirExists(TEXCACHE_DIR);
+    TexCacheEnforceBudget();
+    PrefetchStart();
+    BuildSymbolIndex(&packs);
 
     // Charge le 1er pack par défaut
-    int ddPack = 0, ddPackEdit = false;
-    int ddSym  = 0, ddSymEdit  = false;
+    int ddPack = 0;
+    int ddSym  = 0;
 
-    SwfPack sw = LoadSwfPackFromJson(packs.arr[ddPack].jsonPath);
+    SwfPack sw = AcquirePack(packs.arr[ddPack].jsonPath);
 
-    // Construit la liste des symboles
-    char* ddSyms = NULL;
-    {
-        size_t tot = 1;
-        for (int i = 0; i < sw.symbolCount; ++i) tot += strlen(sw.symbols[i].name) + 1;
-        ddSyms = (char*)MemAlloc(tot);
-        ddSyms[0] = 0;
-        for (int i = 0; i < sw.symbolCount; ++i) {
-            strcat(ddSyms, sw.symbols[i].name);
-            if (i < sw.symbolCount - 1) strcat(ddSyms, ";");
-        }
-    }
+    BrowserSetSymbols(&symBrowser, &sw);
 
     // Animation state
     int   curFrame = 0;
@@ -457,16 +2520,52 @@ int main(void) {
     Vector2 P = { 640.0f, 580.0f };
     float  previewScale = 1.0f;
 
+    // recherche de symbole sur tous les packs (index global)
+    char searchText[64] = "", lastQuery[64] = "";
+    bool searchEdit = false;
+    int  searchHits[SYMINDEX_RESULTS], searchHitCount = 0;
+    double searchMs = 0.0;
+    int  jumpSym = -1;     // symbole à sélectionner une fois le pack demandé chargé
+
     while (!WindowShouldClose()) {
         float dt = GetFrameTime();
+        bool listOpen = packBrowser.open || symBrowser.open;
+        bool typing = searchEdit || listOpen;   // le clavier va au champ de texte, pas aux raccourcis
 
         // Raccourcis
-        if (IsKeyPressed(KEY_A)) gShowAtlas = !gShowAtlas;        // show whole page
-        if (IsKeyPressed(KEY_O)) gIgnoreOffsets = !gIgnoreOffsets; // ignore ox/oy
-        if (IsKeyPressed(KEY_H)) gDrawHit = !gDrawHit;
+        if (!typing && IsKeyPressed(KEY_A)) gShowAtlas = !gShowAtlas;        // show whole page
+        if (!typing && IsKeyPressed(KEY_O)) gIgnoreOffsets = !gIgnoreOffsets; // ignore ox/oy
+        if (!typing && IsKeyPressed(KEY_H)) gDrawHit = !gDrawHit;
+        if (!typing && IsKeyPressed(KEY_M)) gMeshes = !gMeshes;
+        if (!typing && IsKeyPressed(KEY_F)) gHeatmap = !gHeatmap;
+        if (!typing && IsKeyPressed(KEY_L)) {
+            // pages en tableau <-> une texture par page: rechargement du pack courant, symbole conservé
+            gPageArrays = !gPageArrays;
+            ReleasePack(&sw);
+            PrefetchCancel();
+            PackCacheClear();   // les packs résidents ont leurs pages dans l'autre mode
+            sw = AcquirePack(packs.arr[ddPack].jsonPath);
+            BrowserSetSymbols(&symBrowser, &sw);
+            if (ddSym >= sw.symbolCount) ddSym = 0;
+            EnsureSymbolPages(&sw, ddSym);
+            PrefetchSchedule(packs.arr[ddPack].jsonPath, &sw, ddSym,
+                             ddPack > 0 ? packs.arr[ddPack - 1].jsonPath : NULL,
+                             ddPack + 1 < packs.count ? packs.arr[ddPack + 1].jsonPath : NULL);
+            curFrame = 0;
+            curFrameDurationLeft = (sw.symbolCount > 0 && sw.symbols[ddSym].frameCount > 0) ? sw.symbols[ddSym].frames[0].duration : 1;
+        }
 
-        if (IsKeyPressed(KEY_SPACE)) playing = !playing;
-        if (IsKeyPressed(KEY_R)) {
+        // Zoom (molette) : en dessous de 1, le GPU passe sur les mips de la page
+        float wheel = GetMouseWheelMove();
+        if (wheel != 0.0f && !listOpen) {
+            previewScale *= powf(1.1f, wheel);
+            if (previewScale < 0.05f) previewScale = 0.05f;
+            if (previewScale > 4.0f)  previewScale = 4.0f;
+        }
+        if (!typing && IsKeyPressed(KEY_Z)) previewScale = 1.0f;
+
+        if (!typing && IsKeyPressed(KEY_SPACE)) playing = !playing;
+        if (!typing && IsKeyPressed(KEY_R)) {
             curFrame = 0;
             curFrameDurationLeft = (sw.symbolCount ? sw.symbols[ddSym].frames[0].duration : 1);
         }
@@ -491,40 +2590,69 @@ int main(void) {
         BeginDrawing();
         ClearBackground((Color){25,28,36,255});
 
+        // listes ouvertes: dessinées en dernier (par-dessus la scène), le reste de l'UI verrouillé
+        if (listOpen) GuiLock();
         DrawText("SWF Pack", 30, 24, 18, RAYWHITE);
-        if (GuiDropdownBox((Rectangle){30, 45, 380, 30}, ddPacks, &ddPack, ddPackEdit)) ddPackEdit = !ddPackEdit;
-        if (!ddPackEdit) {
-            // si pack changé → reload JSON + rebuild liste symboles
-            static int lastPack = -1;
-            if (lastPack != ddPack) {
-                lastPack = ddPack;
-                if (ddSyms) MemFree(ddSyms);
-                UnloadSwfPack(&sw);
-                sw = LoadSwfPackFromJson(packs.arr[ddPack].jsonPath);
-                ddSym = 0;
-                size_t tot = 1;
-                for (int i = 0; i < sw.symbolCount; ++i) tot += strlen(sw.symbols[i].name) + 1;
-                ddSyms = (char*)MemAlloc(tot);
-                ddSyms[0] = 0;
-                for (int i = 0; i < sw.symbolCount; ++i) {
-                    strcat(ddSyms, sw.symbols[i].name);
-                    if (i < sw.symbolCount - 1) strcat(ddSyms, ";");
-                }
-                // reset anim
-                curFrame = 0;
-                curFrameDurationLeft = (sw.symbolCount > 0 && sw.symbols[0].frameCount > 0) ? sw.symbols[0].frames[0].duration : 1;
-                fps = (sw.fps > 1.0f) ? sw.fps : 24.0f;
-            }
+        BrowserHeader(&packBrowser, (Rectangle){30, 45, 380, 30}, ddPack);
+        DrawText("Symbol", 30, 85, 18, RAYWHITE);
+        BrowserHeader(&symBrowser, (Rectangle){30, 106, 380, 30}, ddSym);
+        if (packBrowser.open || symBrowser.open) searchEdit = false;
+
+        // si pack changé → reload JSON + rebuild liste symboles
+        static int lastPack = -1;
+        if (lastPack != ddPack) {
+            lastPack = ddPack;
+            ReleasePack(&sw);
+            sw = AcquirePack(packs.arr[ddPack].jsonPath);
+            ddSym = (jumpSym >= 0 && jumpSym < sw.symbolCount) ? jumpSym : 0;
+            jumpSym = -1;
+            BrowserSetSymbols(&symBrowser, &sw);
+            // reset anim
+            curFrame = 0;
+            curFrameDurationLeft = (sw.symbolCount > 0 && sw.symbols[ddSym].frameCount > 0) ? sw.symbols[ddSym].frames[0].duration : 1;
+            fps = (sw.fps > 1.0f) ? sw.fps : 24.0f;
+            EnsureSymbolPages(&sw, ddSym);
+            PrefetchSchedule(packs.arr[ddPack].jsonPath, &sw, ddSym,
+                             ddPack > 0 ? packs.arr[ddPack - 1].jsonPath : NULL,
+                             ddPack + 1 < packs.count ? packs.arr[ddPack + 1].jsonPath : NULL);
         }
 
-        DrawText("Symbol", 30, 85, 18, RAYWHITE);
-        if (GuiDropdownBox((Rectangle){30, 106, 380, 30}, ddSyms ? ddSyms : "", &ddSym, ddSymEdit)) ddSymEdit = !ddSymEdit;
-        if (!ddSymEdit) {
-            static int lastSym = -1;
-            if (lastSym != ddSym) {
-                lastSym = ddSym;
-                curFrame = 0;
-                curFrameDurationLeft = (sw.symbolCount > 0 && sw.symbols[ddSym].frameCount > 0) ? sw.symbols[ddSym].frames[0].duration : 1;
+        // si symbole changé → pages du symbole + nouvelle file de préchargement
+        static int lastSym = -1;
+        if (lastSym != ddSym) {
+            lastSym = ddSym;
+            curFrame = 0;
+            curFrameDurationLeft = (sw.symbolCount > 0 && sw.symbols[ddSym].frameCount > 0) ? sw.symbols[ddSym].frames[0].duration : 1;
+            EnsureSymbolPages(&sw, ddSym);
+            PrefetchSchedule(packs.arr[ddPack].jsonPath, &sw, ddSym,
+                             ddPack > 0 ? packs.arr[ddPack - 1].jsonPath : NULL,
+                             ddPack + 1 < packs.count ? packs.arr[ddPack + 1].jsonPath : NULL);
+        }
+        if (!listOpen) PrefetchStep();
+
+        DrawText("Find symbol", 900, 120, 16, RAYWHITE);
+        if (GuiTextBox((Rectangle){1000, 114, 260, 26}, searchText, sizeof(searchText), searchEdit)) searchEdit = !searchEdit;
+        if (strcmp(searchText, lastQuery) != 0) {
+            double t0 = GetTime();
+            searchHitCount = SymIndexSearch(searchText, searchHits, SYMINDEX_RESULTS);
+            searchMs = 1000.0 * (GetTime() - t0);
+            snprintf(lastQuery, sizeof(lastQuery), "%s", searchText);
+        }
+        if (searchText[0]) {
+            char found[96];
+            snprintf(found, sizeof(found), "%d%s hits in %.2f ms (%d symbols, %d packs)", searchHitCount,
+                     searchHitCount == SYMINDEX_RESULTS ? "+" : "", searchMs, gSymIndex.entryCount, gSymIndex.packCount);
+            DrawText(found, 900, 146, 14, (Color){160,180,220,255});
+        }
+        for (int i = 0; i < searchHitCount; ++i) {
+            const SymIndexEntry* e = &gSymIndex.entries[searchHits[i]];
+            char label[160];
+            snprintf(label, sizeof(label), "%s  (%s #%d, %d frames, %d pages)", gSymIndex.blob + gSymIndex.names[e->name],
+                     packs.arr[e->pack].displayName, e->symbol, e->frameCount, e->pageSetCount);
+            if (GuiButton((Rectangle){900, 164.0f + 24.0f*i, 360, 22}, label)) {
+                if (e->pack == ddPack) ddSym = e->symbol;
+                else { ddPack = e->pack; jumpSym = e->symbol; }
+                searchEdit = false;
             }
         }
 
@@ -532,8 +2660,22 @@ int main(void) {
         DrawLine((int)P.x-10, (int)P.y, (int)P.x+10, (int)P.y, RED);
         DrawLine((int)P.x, (int)P.y-10, (int)P.x, (int)P.y+10, RED);
 
+        if (gShowAtlas) EnsurePageLoaded(&sw, 0);
         if (gShowAtlas && sw.pageCount > 0) {
-            DrawTexture(sw.pages[0], 40, 180, WHITE);
+            if (sw.pageArray) {
+                Rectangle page = { 0, 0, (float)sw.pages[0].width, (float)sw.pages[0].height };
+                BeginPageArrayDraw(&sw);
+                rlCheckRenderBatchLimit(4);
+                rlBegin(RL_QUADS);
+                rlColor4ub(255, 255, 255, 255);
+                PageArrayQuad(&sw, 0, page, (Rectangle){ 40, 180, page.width, page.height }, false);
+                rlEnd();
+                EndPageArrayDraw();
+            } else {
+                bool paletted = BeginPageDraw(&sw, 0);
+                DrawTexture(sw.pages[0], 40, 180, WHITE);
+                EndPageDraw(paletted);
+            }
             DrawText("SHOW ATLAS: on (press A to toggle)", 30, 150, 16, (Color){200,200,80,255});
             TraceLog(LOG_INFO, "Draw page0 id=%u size=%dx%d", sw.pages[0].id, sw.pages[0].width, sw.pages[0].height);
         }
@@ -544,6 +2686,20 @@ int main(void) {
             curFrameDurationLeft = (sw.symbolCount > 0 && sw.symbols[ddSym].frameCount > 0) ? sw.symbols[ddSym].frames[0].duration : 1;
         }
         DrawText("Speed", 430, 90, 16, RAYWHITE);
+        {
+            char pagesInfo[128];
+            DescribePackPages(&sw, pagesInfo, sizeof(pagesInfo));
+            DrawText(pagesInfo, 660, 52, 16, (Color){200,200,220,255});
+            char cacheInfo[160];
+            snprintf(cacheInfo, sizeof(cacheInfo), "pack cache: %d resident, %.1f/%d MB, %d hits (+%d prefetched), %d misses, %d shared pages",
+                     gPackCacheCount, PackCacheResidentBytes() / (1024.0 * 1024.0), PACKCACHE_BUDGET_MB,
+                     gPackCacheHits, gPackCachePrefetchHits, gPackCacheMisses, gSharedPageCount);
+            DrawText(cacheInfo, 660, 30, 16, (Color){160,200,160,255});
+            char prefetchInfo[128];
+            snprintf(prefetchInfo, sizeof(prefetchInfo), "prefetch: %d queued, %d steps, %.1f/%d MB warmed",
+                     gPrefetchCount - gPrefetchHead, gPrefetchSteps, gPrefetchBytes / (1024.0 * 1024.0), PREFETCH_BUDGET_MB);
+            DrawText(prefetchInfo, 660, 8, 16, (Color){160,180,220,255});
+        }
 
         DrawLine(0, (int)P.y, GetScreenWidth(), (int)P.y, (Color){120,120,120,80});
 
@@ -552,12 +2708,19 @@ int main(void) {
             Frame f = S->frames[curFrame];
             if (f.page >= 0 && f.page < sw.pageCount) {
                 Texture2D tex = sw.pages[f.page];
-                Rectangle src = { (float)f.x, (float)f.y, (float)f.w, (float)f.h };
                 float dx = P.x + (gIgnoreOffsets ? 0.0f : f.ox*previewScale);
                 float dy = P.y + (gIgnoreOffsets ? 0.0f : f.oy*previewScale);
                 Rectangle dst = { dx, dy, f.w*previewScale, f.h*previewScale };
 
-                DrawTexturePro(tex, src, dst, (Vector2){0,0}, 0.0f, WHITE);
+                // compteur d'overdraw: px rastérisés par la frame vs son quad w x h
+                float quadPx = dst.width * dst.height, shadedPx;
+                if (gHeatmap) {
+                    BeginOverdrawCount();
+                    shadedPx = DrawFrameAt(&sw, &f, dst, previewScale);
+                    EndOverdrawCount();
+                } else {
+                    shadedPx = DrawFrameAt(&sw, &f, dst, previewScale);
+                }
                 if (gDrawHit && f.polyCount > 0) {
                     for (int pi = 0; pi < f.polyCount; ++pi) {
                         Poly* poly = &f.polys[pi];
@@ -593,24 +2756,74 @@ int main(void) {
                          hovered ? (Color){255,200,100,255} : (Color){200,200,220,255});
 
                 DrawRectangleLines((int)dst.x, (int)dst.y, (int)dst.width, (int)dst.height, (Color){0,255,0,120});
+                if (gMeshes && gDrawHit && f.mesh) {
+                    for (int i = 0; i < f.meshCount; ++i) {
+                        Pt a = f.mesh[i], b = f.mesh[(i + 1) % f.meshCount];
+                        DrawLineV((Vector2){dst.x + a.x*previewScale, dst.y + a.y*previewScale},
+                                  (Vector2){dst.x + b.x*previewScale, dst.y + b.y*previewScale}, (Color){80,200,255,200});
+                    }
+                }
+                char fill[128];
+                snprintf(fill, sizeof(fill), "fill (M=mesh %s): %.0f px / quad %.0f px (%+.0f%%)",
+                         gMeshes ? "on" : "off", shadedPx, quadPx, quadPx > 0 ? 100.0f * (shadedPx - quadPx) / quadPx : 0.0f);
+                DrawText(fill, 660, 74, 16, (Color){200,200,220,255});
+                if (gHeatmap) {
+                    char od[160];
+                    snprintf(od, sizeof(od), "overdraw (F): avg %.2f layers/px, max %d, %.0f%% of fragments fully transparent",
+                             gOverdraw.pixels ? (double)gOverdraw.layers / gOverdraw.pixels : 0.0, gOverdraw.maxLayers,
+                             gOverdraw.layers ? 100.0 * gOverdraw.clear / gOverdraw.layers : 0.0);
+                    DrawText(od, 660, 96, 16, (Color){255,200,120,255});
+                }
 
                 char info[256];
                 snprintf(info, sizeof(info),
-                         "%s | Frame %d/%d (dur=%d)  fps=%.1f x%.2f  page=%d  off=(%d,%d)  A=atlas O=ignoreOffs",
-                         S->name, curFrame+1, S->frameCount, f.duration, fps, speed, f.page, f.ox, f.oy);
+                         "%s | Frame %d/%d (dur=%d)  fps=%.1f x%.2f  page=%d  quads=%d  off=(%d,%d)  A=atlas O=ignoreOffs",
+                         S->name, curFrame+1, S->frameCount, f.duration, fps, speed, f.page,
+                         f.tiled ? f.tileCount : 1, f.ox, f.oy);
                 DrawText(info, 30, 680, 18, (Color){200,200,220,255});
+
+                // LOD approximatif que le trilinéaire va échantillonner (borné par les mips de la page)
+                float lod = previewScale < 1.0f ? -log2f(previewScale) : 0.0f;
+                float maxLod = (float)((tex.mipmaps > 1 ? tex.mipmaps : 1) - 1);
+                if (lod > maxLod) lod = maxLod;
+                char zoom[96];
+                snprintf(zoom, sizeof(zoom), "zoom x%.2f (wheel, Z=reset)  mips=%d  LOD~%.1f",
+                         previewScale, tex.mipmaps, lod);
+                DrawText(zoom, 30, 655, 16, (Color){200,200,220,255});
+
+                char pageSetInfo[128];
+                int n = snprintf(pageSetInfo, sizeof(pageSetInfo), "symbol pages:");
+                for (int k = 0; k < S->pageSetCount && n < (int)sizeof(pageSetInfo) - 8; ++k)
+                    n += snprintf(pageSetInfo + n, sizeof(pageSetInfo) - n, " %d", S->pageSet[k]);
+                DrawText(pageSetInfo, 430, 655, 16, (Color){200,200,220,255});
             }
         } else {
             DrawText("No symbols/frames", 30, 680, 18, RED);
         }
 
+        GuiUnlock();
+        BrowserPanel(&packBrowser, (Rectangle){30, 45, 380, 30}, &ddPack);
+        BrowserPanel(&symBrowser, (Rectangle){30, 106, 380, 30}, &ddSym);
+
         EndDrawing();
     }
 
     // cleanup
-    UnloadSwfPack(&sw);
-    if (ddPacks) MemFree(ddPacks);
-    if (ddSyms)  MemFree(ddSyms);
+    PrefetchStop();
+    PrefetchCancel();
+    ReleasePack(&sw);
+    TraceLog(LOG_INFO, "PackCache: %d hits, %d prefetched, %d misses", gPackCacheHits, gPackCachePrefetchHits, gPackCacheMisses);
+    PackCacheClear();
+    if (gSharedPages) MemFree(gSharedPages);
+    UnloadShader(gPaletteShader);
+    UnloadShader(gCountShader);
+    UnloadShader(gPageArrayShader);
+    UnloadOverdraw();
+    SymIndexFree(&gSymIndex);
+    FreeZipDirs();
+    TraceLog(LOG_INFO, "TexCache: %d hits, %d misses", gTexCacheHits, gTexCacheMisses);
+    BrowserFree(&packBrowser);
+    BrowserFree(&symBrowser);
     FreePackList(&packs);
     CloseWindow();
     PHYSFS_deinit();